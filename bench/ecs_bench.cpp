@@ -0,0 +1,488 @@
+// Headless benchmarks for the ECS core. Run with
+//   ecs_bench --benchmark_out=ecs_bench.json --benchmark_out_format=json
+// (or the ecs_bench_json target) to get results for regression tracking.
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ECS/World.h"
+#include "ECS/AllocationCounter.h"
+#include "ECS/JobPool.h"
+#include "ECS/Snapshot.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/Velocity.h"
+#include "ECS/Components/RigidBody.h"
+#include "ECS/Components/Collider.h"
+#include "ECS/Systems/MovementSystem.h"
+#include "ECS/Systems/BoundsSystem.h"
+#include "ECS/Systems/PhysicsSystem.h"
+#include "ECS/Systems/TransformHierarchySystem.h"
+#include "ECS/Systems/SpatialIndexSystem.h"
+
+namespace {
+
+void PopulateMovingEntities(ECS::World& world, int64_t count) {
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> vel(-5.0f, 5.0f);
+
+    for (int64_t i = 0; i < count; ++i) {
+        auto entity = world.CreateEntity();
+        world.AddComponent<ECS::Transform>(entity,
+            ECS::Transform(glm::vec3(pos(gen), pos(gen), pos(gen))));
+        world.AddComponent<ECS::Velocity>(entity,
+            ECS::Velocity(glm::vec3(vel(gen), vel(gen), vel(gen)), glm::vec3(0.0f, 1.0f, 0.0f)));
+    }
+}
+
+void PopulatePhysicsEntities(ECS::World& world, int64_t count) {
+    // Boxes stacked on a grid above a static ground so the broadphase has real pairs
+    auto ground = world.CreateEntity();
+    world.AddComponent<ECS::Transform>(ground, ECS::Transform(glm::vec3(0.0f, -1.0f, 0.0f)));
+    world.AddComponent<ECS::RigidBody>(ground, ECS::RigidBody(0.0f, ECS::RigidBodyType::Static));
+    world.AddComponent<ECS::Collider>(ground, ECS::Collider::Box(glm::vec3(10000.0f, 1.0f, 10000.0f)));
+
+    int64_t side = 1;
+    while (side * side * 10 < count) side++;
+
+    for (int64_t i = 0; i < count; ++i) {
+        int64_t layer = i / (side * side);
+        int64_t x = (i / side) % side;
+        int64_t z = i % side;
+        glm::vec3 position(x * 1.5f - side * 0.75f, 1.0f + layer * 1.1f, z * 1.5f - side * 0.75f);
+
+        auto entity = world.CreateEntity();
+        world.AddComponent<ECS::Transform>(entity, ECS::Transform(position));
+        world.AddComponent<ECS::RigidBody>(entity, ECS::RigidBody(1.0f, ECS::RigidBodyType::Dynamic));
+        world.AddComponent<ECS::Collider>(entity, ECS::Collider::Box(glm::vec3(1.0f)));
+    }
+}
+
+std::bitset<ECS::MAX_COMPONENTS> MovingMask() {
+    std::bitset<ECS::MAX_COMPONENTS> mask;
+    mask.set(ECS::Component::GetTypeId<ECS::Transform>());
+    mask.set(ECS::Component::GetTypeId<ECS::Velocity>());
+    return mask;
+}
+
+}
+
+static void BM_CreateEntities(benchmark::State& state) {
+    for (auto _ : state) {
+        auto world = std::make_unique<ECS::World>();
+        PopulateMovingEntities(*world, state.range(0));
+
+        state.PauseTiming();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateEntities)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Same entities as BM_CreateEntities, created in bulk from a prefab
+static void BM_InstantiatePrefab(benchmark::State& state) {
+    ECS::Prefab prefab;
+    prefab.Add<ECS::Transform>()
+          .Add<ECS::Velocity>(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    for (auto _ : state) {
+        auto world = std::make_unique<ECS::World>();
+        std::mt19937 gen(1234);
+        std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> vel(-5.0f, 5.0f);
+        world->Instantiate(prefab, state.range(0), [&](ECS::PrefabInstance& instance) {
+            instance.Get<ECS::Transform>().position = glm::vec3(pos(gen), pos(gen), pos(gen));
+            instance.Get<ECS::Velocity>().linear = glm::vec3(vel(gen), vel(gen), vel(gen));
+        });
+
+        state.PauseTiming();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InstantiatePrefab)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// One-at-a-time spawns with an add and a remove observer registered, as
+// PhysicsSystem and RenderSystem do; the batch is delivered by one flush
+static void BM_ObservedSpawn(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<ECS::World>();
+        size_t observed = 0;
+        world->OnAdd<ECS::Transform>([&](const ECS::EntityList& entities) { observed += entities.size(); });
+        world->OnRemove<ECS::Transform>([&](const ECS::EntityList& entities) { observed -= entities.size(); });
+        state.ResumeTiming();
+
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            auto entity = world->CreateEntity();
+            world->AddComponent<ECS::Transform>(entity, ECS::Transform(glm::vec3(static_cast<float>(i), 0.0f, 0.0f)));
+        }
+        world->FlushObservers();
+        benchmark::DoNotOptimize(observed);
+
+        state.PauseTiming();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ObservedSpawn)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+// DestroyEntity is linear in the entity count, so this stays at the small sizes;
+// batches go through DestroyEntities below
+static void BM_DestroyEntities(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        ECS::World world;
+        PopulateMovingEntities(world, state.range(0));
+        auto entities = world.GetAllEntities();
+        state.ResumeTiming();
+
+        for (auto& entity : entities) {
+            world.DestroyEntity(entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DestroyEntities)->RangeMultiplier(10)->Range(1000, 10000)->Unit(benchmark::kMillisecond);
+
+static void BM_DestroyEntitiesBatch(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<ECS::World>();
+        PopulateMovingEntities(*world, state.range(0));
+        std::vector<std::shared_ptr<ECS::Entity>> entities;
+        for (const auto& entity : world->GetAllEntities()) {
+            if (entity->GetId() % 2 == 0) entities.push_back(entity);
+        }
+        state.ResumeTiming();
+
+        world->DestroyEntities(entities);
+
+        state.PauseTiming();
+        entities.clear();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(BM_DestroyEntitiesBatch)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Half of a physics world destroyed in one batch; the surviving half keeps its
+// bodies, so this covers the partial-release path of PhysicsSystem
+static void BM_DestroyEntitiesBatchPhysics(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<ECS::World>();
+        world->AddSystem(std::make_unique<ECS::PhysicsSystem>());
+        PopulatePhysicsEntities(*world, state.range(0));
+        world->Update(1.0f / 60.0f);
+        std::vector<std::shared_ptr<ECS::Entity>> entities;
+        for (const auto& entity : world->GetAllEntities()) {
+            if (entity->GetId() % 2 == 0) entities.push_back(entity);
+        }
+        state.ResumeTiming();
+
+        world->DestroyEntities(entities);
+
+        state.PauseTiming();
+        entities.clear();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(BM_DestroyEntitiesBatchPhysics)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+// Chains of ten entities linked by a cascading relation; destroying the roots
+// takes every chain down in one batch
+struct BenchChildOf {};
+
+static void BM_RelationCascadeDestroy(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<ECS::World>();
+        world->SetRelationCleanup<BenchChildOf>(ECS::RelationCleanup::DestroySource);
+        std::vector<std::shared_ptr<ECS::Entity>> roots;
+        for (int64_t i = 0; i < state.range(0) / 10; ++i) {
+            auto parent = world->CreateEntity();
+            roots.push_back(parent);
+            for (int depth = 1; depth < 10; ++depth) {
+                auto child = world->CreateEntity();
+                world->AddPair<BenchChildOf>(child, parent);
+                parent = child;
+            }
+        }
+        state.ResumeTiming();
+
+        world->DestroyEntities(roots);
+
+        state.PauseTiming();
+        roots.clear();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RelationCascadeDestroy)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+static void BM_DestroyAllEntities(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<ECS::World>();
+        PopulateMovingEntities(*world, state.range(0));
+        state.ResumeTiming();
+
+        world->DestroyAllEntities();
+
+        state.PauseTiming();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DestroyAllEntities)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_AddRemoveComponent(benchmark::State& state) {
+    ECS::World world;
+    PopulateMovingEntities(world, state.range(0));
+    auto entities = world.GetAllEntities();
+
+    for (auto _ : state) {
+        for (auto& entity : entities) {
+            world.AddComponent<ECS::Collider>(entity, ECS::Collider::Sphere(0.5f));
+        }
+        for (auto& entity : entities) {
+            world.RemoveComponent<ECS::Collider>(entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AddRemoveComponent)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_QueryIteration(benchmark::State& state) {
+    ECS::World world;
+    PopulateMovingEntities(world, state.range(0));
+    auto mask = MovingMask();
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (auto& entity : world.GetEntitiesWithComponents(mask)) {
+            sum += world.GetComponent<ECS::Transform>(entity)->position.x;
+            sum += world.GetComponent<ECS::Velocity>(entity)->linear.x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QueryIteration)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_MovementSystem(benchmark::State& state) {
+    ECS::World world;
+    world.AddSystem(std::make_unique<ECS::MovementSystem>());
+    PopulateMovingEntities(world, state.range(0));
+
+    for (auto _ : state) {
+        world.Update(1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MovementSystem)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_BoundsSystem(benchmark::State& state) {
+    ECS::World world;
+    world.AddSystem(std::make_unique<ECS::BoundsSystem>());
+    PopulateMovingEntities(world, state.range(0));
+
+    for (auto _ : state) {
+        world.Update(1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BoundsSystem)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Query results and other per-frame scratch come from the frame arena, so
+// after warm-up a frame should report zero allocs_per_frame
+static void BM_SteadyStateFrame(benchmark::State& state) {
+    ECS::World world;
+    world.AddSystem(std::make_unique<ECS::MovementSystem>());
+    world.AddSystem(std::make_unique<ECS::BoundsSystem>());
+    world.AddSystem(std::make_unique<ECS::TransformHierarchySystem>());
+    PopulateMovingEntities(world, state.range(0));
+    for (int i = 0; i < 3; ++i) {
+        world.Update(1.0f / 60.0f);
+    }
+
+    uint64_t allocationsStart = ECS::AllocationCounter::Get();
+    for (auto _ : state) {
+        world.Update(1.0f / 60.0f);
+    }
+    state.counters["allocs_per_frame"] = benchmark::Counter(
+        static_cast<double>(ECS::AllocationCounter::Get() - allocationsStart) / state.iterations());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SteadyStateFrame)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Independent rooms of a server: 64 worlds of 5k entities, one world per job
+// on a pool with range(0) workers (0 steps them one after another)
+static void BM_StepWorldsParallel(benchmark::State& state) {
+    const size_t WORLD_COUNT = 64;
+    const int64_t ENTITIES_PER_WORLD = 5000;
+
+    std::vector<std::unique_ptr<ECS::World>> worlds;
+    for (size_t i = 0; i < WORLD_COUNT; ++i) {
+        auto world = std::make_unique<ECS::World>();
+        world->AddSystem(std::make_unique<ECS::MovementSystem>());
+        world->AddSystem(std::make_unique<ECS::BoundsSystem>());
+        world->AddSystem(std::make_unique<ECS::TransformHierarchySystem>());
+        world->AddSystem(std::make_unique<ECS::SpatialIndexSystem>());
+        PopulateMovingEntities(*world, ENTITIES_PER_WORLD);
+        world->Update(1.0f / 60.0f);
+        worlds.push_back(std::move(world));
+    }
+
+    ECS::JobPool pool(static_cast<unsigned>(state.range(0)));
+    for (auto _ : state) {
+        pool.ParallelFor(worlds.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                worlds[i]->Update(1.0f / 60.0f);
+            }
+        });
+    }
+    state.counters["threads"] = pool.GetThreadCount();
+    state.SetItemsProcessed(state.iterations() * WORLD_COUNT * ENTITIES_PER_WORLD);
+}
+BENCHMARK(BM_StepWorldsParallel)->Arg(0)->Arg(1)->Arg(3)->Arg(7)->Arg(15)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same rooms with physics: each world steps its own Bullet world, and
+// all of them take their shapes from one shared CollisionShapeLibrary
+static void BM_StepPhysicsWorldsParallel(benchmark::State& state) {
+    const size_t WORLD_COUNT = 64;
+    const int64_t BODIES_PER_WORLD = 1000;
+
+    auto shapes = std::make_shared<ECS::CollisionShapeLibrary>();
+    std::vector<std::unique_ptr<ECS::World>> worlds;
+    for (size_t i = 0; i < WORLD_COUNT; ++i) {
+        auto world = std::make_unique<ECS::World>();
+        auto physics = std::make_unique<ECS::PhysicsSystem>();
+        physics->SetShapeLibrary(shapes);
+        world->AddSystem(std::move(physics));
+        world->AddSystem(std::make_unique<ECS::TransformHierarchySystem>());
+        PopulatePhysicsEntities(*world, BODIES_PER_WORLD);
+        world->Update(1.0f / 60.0f);
+        worlds.push_back(std::move(world));
+    }
+
+    ECS::JobPool pool(static_cast<unsigned>(state.range(0)));
+    for (auto _ : state) {
+        pool.ParallelFor(worlds.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                worlds[i]->Update(1.0f / 60.0f);
+            }
+        });
+    }
+    state.counters["threads"] = pool.GetThreadCount();
+    state.counters["shapes"] = static_cast<double>(shapes->GetShapeCount());
+    state.SetItemsProcessed(state.iterations() * WORLD_COUNT * BODIES_PER_WORLD);
+}
+BENCHMARK(BM_StepPhysicsWorldsParallel)->Arg(0)->Arg(1)->Arg(3)->Arg(7)->Arg(15)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_SpatialIndexRebuild(benchmark::State& state) {
+    ECS::World world;
+    world.AddSystem(std::make_unique<ECS::MovementSystem>());
+    world.AddSystem(std::make_unique<ECS::SpatialIndexSystem>());
+    PopulateMovingEntities(world, state.range(0));
+
+    // Every entity moves each frame, so each update is a full parallel rebuild
+    for (auto _ : state) {
+        world.Update(1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialIndexRebuild)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_SpatialIndexQuery(benchmark::State& state) {
+    ECS::World world;
+    world.AddSystem(std::make_unique<ECS::SpatialIndexSystem>());
+    PopulateMovingEntities(world, state.range(0));
+    world.Update(1.0f / 60.0f);
+    auto* index = world.GetSystem<ECS::SpatialIndexSystem>();
+
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+    for (auto _ : state) {
+        glm::vec3 point(pos(gen), pos(gen), pos(gen));
+        benchmark::DoNotOptimize(index->QueryRadius(point, 5.0f).size());
+        benchmark::DoNotOptimize(index->QueryNearest(point, 8).size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndexQuery)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_PhysicsStep(benchmark::State& state) {
+    ECS::World world;
+    world.AddSystem(std::make_unique<ECS::PhysicsSystem>());
+    PopulatePhysicsEntities(world, state.range(0));
+
+    // First update creates the bodies; time the steady-state steps only
+    world.Update(1.0f / 60.0f);
+
+    for (auto _ : state) {
+        world.Update(1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PhysicsStep)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_PhysicsBodyCreation(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto world = std::make_unique<ECS::World>();
+        world->AddSystem(std::make_unique<ECS::PhysicsSystem>());
+        PopulatePhysicsEntities(*world, state.range(0));
+        auto* physics = world->GetSystem<ECS::PhysicsSystem>();
+        std::bitset<ECS::MAX_COMPONENTS> mask;
+        mask.set(ECS::Component::GetTypeId<ECS::Transform>());
+        mask.set(ECS::Component::GetTypeId<ECS::RigidBody>());
+        mask.set(ECS::Component::GetTypeId<ECS::Collider>());
+        auto entities = world->GetEntitiesWithComponents(mask);
+        state.ResumeTiming();
+
+        physics->CreateRigidBodies(entities);
+
+        state.PauseTiming();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PhysicsBodyCreation)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+static void BM_SnapshotLoad(benchmark::State& state) {
+    const std::string path = "ecs_bench_snapshot.bin";
+    {
+        ECS::World world;
+        PopulatePhysicsEntities(world, state.range(0));
+        ECS::SaveSnapshot(world, path);
+    }
+
+    for (auto _ : state) {
+        auto world = std::make_unique<ECS::World>();
+        ECS::LoadSnapshot(*world, path);
+
+        state.PauseTiming();
+        world.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_SnapshotLoad)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,33 @@
+#ifndef ECS_ALLOCATION_COUNTER_H
+#define ECS_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace ECS {
+
+// Heap allocations made by the calling thread. The global operator new
+// replacements in AllocationTracking.cpp bump it when built with
+// ECS_TRACK_ALLOCATIONS; otherwise it stays at zero. Per thread, so a World
+// is charged only for its own work: JobPool::ParallelFor credits the
+// allocations its workers made for a batch to the thread that issued it.
+class AllocationCounter {
+public:
+    static void Increment() { ++allocations; }
+    static void Add(uint64_t count) { allocations += count; }
+    static uint64_t Get() { return allocations; }
+    
+    static constexpr bool IsTracking() {
+#ifdef ECS_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    static inline thread_local uint64_t allocations = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
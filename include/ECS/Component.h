@@ -1,12 +1,18 @@
 #ifndef ECS_COMPONENT_H
 #define ECS_COMPONENT_H
 
+#include <atomic>
 #include <cstdint>
 #include <typeindex>
 #include <typeinfo>
 
 namespace ECS {
 
+class World;
+
+// Base for components stored behind a pointer. The World also accepts plain
+// structs, which it stores inline; deriving from Component keeps a stable
+// address and the tick accessors below.
 class Component {
 public:
     Component() = default;
@@ -18,8 +24,17 @@ public:
         return typeId;
     }
     
+    // World change ticks of when this component was added and last
+    // accessed mutably; compare against a system's GetLastRunTick()
+    uint32_t GetAddedTick() const { return addedTick; }
+    uint32_t GetChangedTick() const { return changedTick; }
+
 private:
-    static uint32_t nextTypeId;
+    friend class World;
+    
+    static std::atomic<uint32_t> nextTypeId;
+    uint32_t addedTick = 0;
+    uint32_t changedTick = 0;
 };
 
 }
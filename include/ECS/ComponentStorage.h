@@ -0,0 +1,251 @@
+#ifndef ECS_COMPONENT_STORAGE_H
+#define ECS_COMPONENT_STORAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Component.h"
+
+namespace ECS {
+
+// Types derived from Component go through an adapter: storage holds a
+// unique_ptr to them, so their address never moves and their ticks are
+// mirrored into the object. Any other type is stored inline, by value, and
+// densely; trivially copyable ones (Transform, Velocity, Renderable,
+// Collider, which static_assert it) are moved and copied with memcpy.
+template<typename T>
+constexpr bool IsBoxedComponent = std::is_base_of_v<Component, T>;
+
+template<typename T>
+using StoredComponent = std::conditional_t<IsBoxedComponent<T>, std::unique_ptr<Component>, T>;
+
+// What ComponentStorage needs to manage a stored type without knowing it
+struct ComponentTypeInfo {
+    size_t size;
+    size_t alignment;
+    bool trivial;                             // Moved with memcpy, nothing to destroy
+    void (*relocate)(void* dst, void* src);   // Move-constructs dst from src, then destroys src
+    void (*destroy)(void* ptr);
+
+    template<typename S>
+    static const ComponentTypeInfo& Of() {
+        static const ComponentTypeInfo info = {
+            sizeof(S),
+            alignof(S),
+            std::is_trivially_copyable_v<S>,
+            [](void* dst, void* src) {
+                new (dst) S(std::move(*static_cast<S*>(src)));
+                static_cast<S*>(src)->~S();
+            },
+            [](void* ptr) { static_cast<S*>(ptr)->~S(); }
+        };
+        return info;
+    }
+};
+
+struct ComponentTicks {
+    uint32_t added = 0;
+    uint32_t changed = 0;
+};
+
+// Sparse set for one component type: components packed densely, with a
+// paged entity id -> index table. Removal moves the last component into
+// the hole, so pointers to inline components only stay valid until the
+// next add or remove of the same type.
+class ComponentStorage {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr size_t PAGE_SIZE = 1024;
+    static constexpr size_t MIN_ALIGNMENT = 64;  // Cache line; enough for any SIMD load
+
+    explicit ComponentStorage(const ComponentTypeInfo& info) : info(info) {}
+
+    ~ComponentStorage() {
+        Clear();
+        ::operator delete(data, std::align_val_t(Alignment()));
+    }
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    const ComponentTypeInfo& GetTypeInfo() const { return info; }
+    size_t Size() const { return entityIds.size(); }
+
+    void* Data() { return data; }
+    const void* Data() const { return data; }
+    const uint32_t* EntityIds() const { return entityIds.data(); }
+    ComponentTicks* Ticks() { return ticks.data(); }
+    const ComponentTicks* Ticks() const { return ticks.data(); }
+
+    void* At(size_t index) { return data + index * info.size; }
+    const void* At(size_t index) const { return data + index * info.size; }
+
+    uint32_t IndexOf(uint32_t entityId) const {
+        size_t page = entityId / PAGE_SIZE;
+        if (page >= sparse.size() || !sparse[page]) return NONE;
+        return sparse[page][entityId % PAGE_SIZE];
+    }
+
+    // Uninitialised slot for the entity's component, with both ticks set.
+    // An existing component is destroyed first and keeps its added tick, as
+    // replacing counts as a change; the caller constructs into the slot
+    // before touching the storage again.
+    void* Insert(uint32_t entityId, uint32_t tick) {
+        uint32_t index = IndexOf(entityId);
+        if (index != NONE) {
+            if (!info.trivial) info.destroy(At(index));
+            ticks[index].changed = tick;
+            return At(index);
+        }
+
+        if (Size() == capacity) {
+            Grow(std::max<size_t>(capacity * 2, 16));
+        }
+        index = static_cast<uint32_t>(Size());
+        SparseSlot(entityId) = index;
+        entityIds.push_back(entityId);
+        ticks.push_back({tick, tick});
+        return At(index);
+    }
+
+    // Uninitialised slots for entities that have no component of this type
+    // yet, e.g. ones just created. Returns the index of the first.
+    uint32_t Append(const uint32_t* ids, size_t count, uint32_t tick) {
+        if (Size() + count > capacity) {
+            Grow(std::max(capacity * 2, Size() + count));
+        }
+        uint32_t first = static_cast<uint32_t>(Size());
+        for (size_t i = 0; i < count; ++i) {
+            SparseSlot(ids[i]) = first + static_cast<uint32_t>(i);
+        }
+        entityIds.insert(entityIds.end(), ids, ids + count);
+        ticks.insert(ticks.end(), count, ComponentTicks{tick, tick});
+        return first;
+    }
+    
+    bool Remove(uint32_t entityId) {
+        uint32_t index = IndexOf(entityId);
+        if (index == NONE) return false;
+
+        if (!info.trivial) info.destroy(At(index));
+        uint32_t last = static_cast<uint32_t>(Size() - 1);
+        if (index != last) {
+            Relocate(At(index), At(last));
+            entityIds[index] = entityIds[last];
+            ticks[index] = ticks[last];
+            SparseSlot(entityIds[index]) = index;
+        }
+        SparseSlot(entityId) = NONE;
+        entityIds.pop_back();
+        ticks.pop_back();
+        return true;
+    }
+
+    // Removes the components of many entities at once. A small batch is
+    // swap-removed; a large one is compacted in a single pass that keeps the
+    // order of the survivors. Ids without a component here are ignored.
+    void RemoveMany(const uint32_t* ids, size_t count) {
+        if (count * 4 < Size()) {
+            for (size_t i = 0; i < count; ++i) {
+                Remove(ids[i]);
+            }
+            return;
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t index = IndexOf(ids[i]);
+            if (index == NONE) continue;
+            if (!info.trivial) info.destroy(At(index));
+            SparseSlot(ids[i]) = NONE;
+            entityIds[index] = NONE;
+        }
+        
+        size_t kept = 0;
+        for (size_t index = 0; index < Size(); ++index) {
+            if (entityIds[index] == NONE) continue;
+            if (kept != index) {
+                Relocate(At(kept), At(index));
+                entityIds[kept] = entityIds[index];
+                ticks[kept] = ticks[index];
+                SparseSlot(entityIds[kept]) = static_cast<uint32_t>(kept);
+            }
+            kept++;
+        }
+        entityIds.resize(kept);
+        ticks.resize(kept);
+    }
+    
+    void Reserve(size_t count) {
+        if (count > capacity) Grow(count);
+    }
+
+    void Clear() {
+        if (!info.trivial) {
+            for (size_t i = 0; i < Size(); ++i) {
+                info.destroy(At(i));
+            }
+        }
+        for (uint32_t entityId : entityIds) {
+            SparseSlot(entityId) = NONE;
+        }
+        entityIds.clear();
+        ticks.clear();
+    }
+
+private:
+    size_t Alignment() const { return std::max(info.alignment, MIN_ALIGNMENT); }
+
+    void Relocate(void* dst, void* src) {
+        if (info.trivial) {
+            std::memcpy(dst, src, info.size);
+        } else {
+            info.relocate(dst, src);
+        }
+    }
+
+    void Grow(size_t newCapacity) {
+        auto* newData = static_cast<std::byte*>(
+            ::operator new(newCapacity * info.size, std::align_val_t(Alignment())));
+        if (info.trivial) {
+            if (Size()) std::memcpy(newData, data, Size() * info.size);
+        } else {
+            for (size_t i = 0; i < Size(); ++i) {
+                info.relocate(newData + i * info.size, At(i));
+            }
+        }
+        ::operator delete(data, std::align_val_t(Alignment()));
+        data = newData;
+        capacity = newCapacity;
+        entityIds.reserve(newCapacity);
+        ticks.reserve(newCapacity);
+    }
+
+    uint32_t& SparseSlot(uint32_t entityId) {
+        size_t page = entityId / PAGE_SIZE;
+        if (page >= sparse.size()) {
+            sparse.resize(page + 1);
+        }
+        if (!sparse[page]) {
+            sparse[page] = std::make_unique<uint32_t[]>(PAGE_SIZE);
+            std::fill_n(sparse[page].get(), PAGE_SIZE, NONE);
+        }
+        return sparse[page][entityId % PAGE_SIZE];
+    }
+
+    const ComponentTypeInfo& info;
+    std::byte* data = nullptr;
+    size_t capacity = 0;
+    std::vector<uint32_t> entityIds;      // Parallel to data
+    std::vector<ComponentTicks> ticks;    // Parallel to data
+    std::vector<std::unique_ptr<uint32_t[]>> sparse;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,8 +1,8 @@
 #ifndef ECS_COLLIDER_H
 #define ECS_COLLIDER_H
 
+#include <type_traits>
 #include <glm/glm.hpp>
-#include "../Component.h"
 
 namespace ECS {
 
@@ -14,8 +14,9 @@ enum class ColliderType {
     Mesh
 };
 
-class Collider : public Component {
-public:
+// Shape of the entity's physics body. Which of size, radius and height
+// apply depends on type; for Plane, size holds the normal.
+struct Collider {
     ColliderType type;
     glm::vec3 size;
     glm::vec3 offset;
@@ -53,6 +54,8 @@ public:
     }
 };
 
+static_assert(std::is_trivially_copyable_v<Collider>, "Collider is moved with memcpy");
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef ECS_HIERARCHY_H
+#define ECS_HIERARCHY_H
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../Component.h"
+#include "../Entity.h"
+
+namespace ECS {
+
+// Use TransformHierarchySystem::SetParent/RemoveParent to keep Parent and
+// Children consistent rather than editing them directly.
+class Parent : public Component {
+public:
+    std::shared_ptr<Entity> entity;
+    
+    Parent(std::shared_ptr<Entity> parent = nullptr) : entity(std::move(parent)) {}
+};
+
+class Children : public Component {
+public:
+    std::vector<std::shared_ptr<Entity>> entities;
+};
+
+// Cached local-to-world matrix, written by TransformHierarchySystem
+class WorldTransform : public Component {
+public:
+    glm::mat4 matrix;
+    
+    WorldTransform(const glm::mat4& m = glm::mat4(1.0f)) : matrix(m) {}
+    
+    glm::vec3 GetPosition() const {
+        return glm::vec3(matrix[3]);
+    }
+};
+
+}
+
+#endif
\ No newline at end of file
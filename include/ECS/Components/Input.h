@@ -2,20 +2,50 @@
 #define ECS_INPUT_H
 
 #include <glm/glm.hpp>
-#include <unordered_map>
+#include <bitset>
 #include "../Component.h"
 
 namespace ECS {
 
-enum class KeyState {
-    Released,
-    Pressed,
-    Held
-};
+// Key codes share GLFW's values so window input can be passed straight
+// through, while headless code can use them without including GLFW.
+namespace Key {
+    constexpr int Space = 32;
+    constexpr int Num1 = 49;
+    constexpr int Num2 = 50;
+    constexpr int Num3 = 51;
+    constexpr int Num4 = 52;
+    constexpr int Num5 = 53;
+    constexpr int Num6 = 54;
+    constexpr int A = 65;
+    constexpr int D = 68;
+    constexpr int E = 69;
+    constexpr int F = 70;
+    constexpr int Q = 81;
+    constexpr int R = 82;
+    constexpr int S = 83;
+    constexpr int W = 87;
+    constexpr int Escape = 256;
+    constexpr int Enter = 257;
+    constexpr int Tab = 258;
+    constexpr int Right = 262;
+    constexpr int Left = 263;
+    constexpr int Down = 264;
+    constexpr int Up = 265;
+    constexpr int LeftShift = 340;
+    constexpr int LeftControl = 341;
+}
 
+// Key state lives in fixed bitsets indexed by key code. Input systems call
+// BeginFrame and then UpdateKey for each key event, so Pressed/Released
+// are edges seen by every system later in the same frame.
 class Input : public Component {
 public:
-    std::unordered_map<int, KeyState> keys;
+    static constexpr int MAX_KEYS = 512;  // Covers GLFW_KEY_LAST
+    
+    std::bitset<MAX_KEYS> keysDown;
+    std::bitset<MAX_KEYS> keysPressed;   // Went down this frame
+    std::bitset<MAX_KEYS> keysReleased;  // Went up this frame
     glm::vec2 mousePosition;
     glm::vec2 mouseDelta;
     glm::vec2 scrollDelta;
@@ -23,41 +53,36 @@ public:
     
     Input() : mousePosition(0.0f), mouseDelta(0.0f), scrollDelta(0.0f) {}
     
+    static bool IsValidKey(int key) {
+        return key >= 0 && key < MAX_KEYS;
+    }
+    
     bool IsKeyPressed(int key) const {
-        auto it = keys.find(key);
-        return it != keys.end() && it->second == KeyState::Pressed;
+        return IsValidKey(key) && keysPressed.test(key);
     }
     
     bool IsKeyHeld(int key) const {
-        auto it = keys.find(key);
-        return it != keys.end() && 
-               (it->second == KeyState::Pressed || it->second == KeyState::Held);
+        return IsValidKey(key) && keysDown.test(key);
     }
     
     bool IsKeyReleased(int key) const {
-        auto it = keys.find(key);
-        return it != keys.end() && it->second == KeyState::Released;
+        return IsValidKey(key) && keysReleased.test(key);
     }
     
+    // A press and release within one frame leaves both edges set
     void UpdateKey(int key, bool pressed) {
-        auto it = keys.find(key);
+        if (!IsValidKey(key) || keysDown.test(key) == pressed) return;
+        keysDown.set(key, pressed);
         if (pressed) {
-            if (it == keys.end() || it->second == KeyState::Released) {
-                keys[key] = KeyState::Pressed;
-            } else if (it->second == KeyState::Pressed) {
-                keys[key] = KeyState::Held;
-            }
+            keysPressed.set(key);
         } else {
-            keys[key] = KeyState::Released;
+            keysReleased.set(key);
         }
     }
     
-    void EndFrame() {
-        for (auto& [key, state] : keys) {
-            if (state == KeyState::Pressed) {
-                state = KeyState::Held;
-            }
-        }
+    void BeginFrame() {
+        keysPressed.reset();
+        keysReleased.reset();
         mouseDelta = glm::vec2(0.0f);
         scrollDelta = glm::vec2(0.0f);
     }
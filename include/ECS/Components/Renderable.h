@@ -1,8 +1,8 @@
 #ifndef ECS_RENDERABLE_H
 #define ECS_RENDERABLE_H
 
+#include <type_traits>
 #include <glm/glm.hpp>
-#include "../Component.h"
 
 namespace ECS {
 
@@ -13,8 +13,8 @@ enum class MeshType {
     Custom
 };
 
-class Renderable : public Component {
-public:
+// What RenderSystem draws for the entity; invisible ones are skipped
+struct Renderable {
     MeshType meshType;
     glm::vec3 color;
     bool visible;
@@ -27,6 +27,8 @@ public:
         : meshType(type), color(col), visible(vis), opacity(op) {}
 };
 
+static_assert(std::is_trivially_copyable_v<Renderable>, "Renderable is moved with memcpy");
+
 }
 
 #endif
\ No newline at end of file
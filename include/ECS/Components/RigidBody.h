@@ -25,6 +25,7 @@ public:
     float angularDamping;
     float friction;
     float restitution;
+    bool reportContacts;  // Read at body creation, see PhysicsSystem::GetContactEvents
     
     btRigidBody* bulletBody;
     btCollisionShape* collisionShape;
@@ -34,6 +35,7 @@ public:
           linearVelocity(0.0f), angularVelocity(0.0f),
           linearDamping(0.0f), angularDamping(0.0f),
           friction(0.5f), restitution(0.0f),
+          reportContacts(false),
           bulletBody(nullptr), collisionShape(nullptr) {}
     
     ~RigidBody() {
@@ -1,16 +1,85 @@
 #ifndef ECS_TAG_H
 #define ECS_TAG_H
 
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include "../Component.h"
+#include "../Log.h"
 
 namespace ECS {
 
+using TagId = uint32_t;
+
+// FNV-1a, so tag names known at compile time hash to constants
+constexpr TagId HashTag(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Tags used by the demo scene and its systems
+namespace Tags {
+    constexpr TagId Player = HashTag("Player");
+    constexpr TagId Cube = HashTag("Cube");
+    constexpr TagId Spawned = HashTag("Spawned");
+    constexpr TagId Ground = HashTag("Ground");
+}
+
+// Maps interned ids back to their names for logging and snapshots
+class TagRegistry {
+public:
+    static TagId Intern(std::string_view name) {
+        TagId id = HashTag(name);
+        std::lock_guard<std::mutex> lock(Mutex());
+        auto [it, inserted] = Names().try_emplace(id, name);
+        if (!inserted && it->second != name) {
+            ECS_LOG_ERROR("Tag id {} collides with existing tag '{}'", id, it->second.c_str());
+        }
+        return id;
+    }
+    
+    // Empty for ids that were never interned
+    static const std::string& GetName(TagId id) {
+        static const std::string empty;
+        std::lock_guard<std::mutex> lock(Mutex());
+        auto it = Names().find(id);
+        return it != Names().end() ? it->second : empty;
+    }
+
+private:
+    static std::unordered_map<TagId, std::string>& Names() {
+        static std::unordered_map<TagId, std::string> names;
+        return names;
+    }
+    
+    static std::mutex& Mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+};
+
+// A named tag. The World keeps a tag -> entities index, so look entities up
+// with World::GetEntitiesWithTag instead of scanning and comparing names.
+// The id is fixed at construction so the index cannot go stale.
 class Tag : public Component {
 public:
-    std::string name;
+    Tag(std::string_view name = "") : id(TagRegistry::Intern(name)) {}
+    
+    TagId GetId() const { return id; }
+    const std::string& GetName() const { return TagRegistry::GetName(id); }
+    bool Is(TagId other) const { return id == other; }
+
+private:
+    friend class World;
     
-    Tag(const std::string& tagName = "") : name(tagName) {}
+    TagId id;
+    uint32_t indexSlot = 0;  // Position in the World's bucket for this id
 };
 
 }
@@ -1,14 +1,15 @@
 #ifndef ECS_TRANSFORM_H
 #define ECS_TRANSFORM_H
 
+#include <type_traits>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
-#include "../Component.h"
 
 namespace ECS {
 
-class Transform : public Component {
-public:
+// Relative to the parent when the entity has one; TransformHierarchySystem
+// composes the world-space result into WorldTransform
+struct Transform {
     glm::vec3 position;
     glm::quat rotation;
     glm::vec3 scale;
@@ -38,6 +39,8 @@ public:
     }
 };
 
+static_assert(std::is_trivially_copyable_v<Transform>, "Transform is moved with memcpy");
+
 }
 
 #endif
\ No newline at end of file
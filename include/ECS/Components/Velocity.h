@@ -1,13 +1,14 @@
 #ifndef ECS_VELOCITY_H
 #define ECS_VELOCITY_H
 
+#include <type_traits>
 #include <glm/glm.hpp>
-#include "../Component.h"
 
 namespace ECS {
 
-class Velocity : public Component {
-public:
+// Integrated by MovementSystem for entities without a physics body. Angular
+// is a rotation axis scaled by its speed in radians per second.
+struct Velocity {
     glm::vec3 linear;
     glm::vec3 angular;
     
@@ -16,6 +17,8 @@ public:
         : linear(lin), angular(ang) {}
 };
 
+static_assert(std::is_trivially_copyable_v<Velocity>, "Velocity is moved with memcpy");
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef ECS_DEMO_SCENE_H
+#define ECS_DEMO_SCENE_H
+
+#include <memory>
+#include <random>
+#include "World.h"
+
+namespace ECS {
+
+// Populates the world with the demo content shared by the windowed and
+// headless executables: a physics-driven player, randomly placed cubes
+// and a static ground. Returns the player entity.
+std::shared_ptr<Entity> CreateDemoScene(World& world, std::mt19937& gen, int cubeCount);
+
+}
+
+#endif
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <bitset>
+#include <memory>
+#include "FrameArena.h"
 
 namespace ECS {
 
@@ -20,6 +22,10 @@ public:
         componentMask.set(typeId);
     }
     
+    void AddComponentTypes(const std::bitset<MAX_COMPONENTS>& mask) {
+        componentMask |= mask;
+    }
+    
     void RemoveComponentType(uint32_t typeId) {
         componentMask.reset(typeId);
     }
@@ -38,6 +44,10 @@ private:
     std::bitset<MAX_COMPONENTS> componentMask;
 };
 
+// Query results. Filled from the frame arena during Update, so they are only
+// valid until the end of the frame; copy one to keep it longer.
+using EntityList = FrameVector<std::shared_ptr<Entity>>;
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef ECS_CONTACT_EVENTS_H
+#define ECS_CONTACT_EVENTS_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace ECS {
+
+enum class ContactEventType {
+    Begin,
+    Stay,
+    End
+};
+
+struct ContactEvent {
+    ContactEventType type;
+    uint32_t entityA;
+    uint32_t entityB;
+    glm::vec3 point;    // World-space point on B (zero for End events)
+    glm::vec3 normal;   // World-space normal pointing from B to A
+    float impulse;
+};
+
+// Frame-scoped list of contact events. Storage is reused between frames,
+// so once capacity has warmed up no allocation happens on the hot path.
+class ContactEventBuffer {
+public:
+    void Clear() { events.clear(); }
+    void Reserve(size_t count) { events.reserve(count); }
+    void Push(const ContactEvent& event) { events.push_back(event); }
+
+    size_t Size() const { return events.size(); }
+    bool Empty() const { return events.empty(); }
+    const ContactEvent& operator[](size_t index) const { return events[index]; }
+
+    std::vector<ContactEvent>::const_iterator begin() const { return events.begin(); }
+    std::vector<ContactEvent>::const_iterator end() const { return events.end(); }
+
+    template<typename Func>
+    void ForEntity(uint32_t entityId, Func&& func) const {
+        for (const auto& event : events) {
+            if (event.entityA == entityId || event.entityB == entityId) {
+                func(event);
+            }
+        }
+    }
+
+private:
+    std::vector<ContactEvent> events;
+};
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef ECS_FRAME_ARENA_H
+#define ECS_FRAME_ARENA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ECS {
+
+// Bump allocator for data that lives until the end of a frame. Individual
+// frees are no-ops; Reset rewinds everything at once. A frame that spills
+// past the first block gets a single block sized for the whole frame at the
+// next Reset, so a steady-state frame does not touch the heap.
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    
+    explicit FrameArena(size_t initialSize = DEFAULT_BLOCK_SIZE) : nextBlockSize(initialSize) {}
+    
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (!blocks.empty()) {
+            Block& block = blocks.back();
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+            uintptr_t aligned = (base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            size_t end = static_cast<size_t>(aligned - base) + size;
+            if (end <= block.size) {
+                bytesUsed += end - offset;
+                offset = end;
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+        return AllocateBlock(size, alignment);
+    }
+    
+    template<typename T>
+    T* AllocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    void Reset() {
+        if (blocks.size() > 1) {
+            size_t total = 0;
+            for (const auto& block : blocks) total += block.size;
+            blocks.clear();
+            nextBlockSize = total;
+        }
+        offset = 0;
+        bytesUsed = 0;
+    }
+    
+    size_t GetBytesUsed() const { return bytesUsed; }
+    size_t GetCapacity() const {
+        size_t total = 0;
+        for (const auto& block : blocks) total += block.size;
+        return total;
+    }
+    
+    // The calling thread's arena, reset the first time it is asked for with a
+    // new frame key. Each World takes a fresh key from NewFrameKey every frame.
+    static FrameArena& ForThread(uint64_t frameKey) {
+        thread_local FrameArena arena;
+        thread_local uint64_t arenaKey = 0;
+        if (arenaKey != frameKey) {
+            arena.Reset();
+            arenaKey = frameKey;
+        }
+        return arena;
+    }
+    
+    static uint64_t NewFrameKey() {
+        static std::atomic<uint64_t> nextKey{1};
+        return nextKey.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+    
+    void* AllocateBlock(size_t size, size_t alignment) {
+        size_t blockSize = std::max(nextBlockSize, size + alignment);
+        blocks.push_back({std::make_unique<std::byte[]>(blockSize), blockSize});
+        nextBlockSize = blockSize * 2;
+        
+        uintptr_t base = reinterpret_cast<uintptr_t>(blocks.back().data.get());
+        uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        offset = static_cast<size_t>(aligned - base) + size;
+        bytesUsed += offset;
+        return reinterpret_cast<void*>(aligned);
+    }
+    
+    std::vector<Block> blocks;
+    size_t offset = 0;       // Into blocks.back()
+    size_t bytesUsed = 0;    // This frame, alignment padding included
+    size_t nextBlockSize;
+};
+
+// STL allocator over a FrameArena. A null arena falls back to the heap, so a
+// container keeps one type whether or not it was filled during a frame.
+// Copies always go to the heap, which is how a result outlives its frame.
+template<typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+    
+    FrameAllocator(FrameArena* arena = nullptr) noexcept : arena(arena) {}
+    
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : arena(other.GetArena()) {}
+    
+    T* allocate(size_t count) {
+        if (!arena) return std::allocator<T>().allocate(count);
+        return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T* ptr, size_t count) noexcept {
+        if (!arena) std::allocator<T>().deallocate(ptr, count);
+    }
+    
+    FrameAllocator select_on_container_copy_construction() const { return FrameAllocator(); }
+    
+    FrameArena* GetArena() const noexcept { return arena; }
+    
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return arena == other.GetArena(); }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept { return arena != other.GetArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}
+
+#endif
\ No newline at end of file
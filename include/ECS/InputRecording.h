@@ -0,0 +1,117 @@
+#ifndef ECS_INPUT_RECORDING_H
+#define ECS_INPUT_RECORDING_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace ECS {
+
+// Input state captured once per World::Update. Keys are stored as
+// press/release transitions; everything else is stored as a snapshot.
+struct InputFrame {
+    float deltaTime;
+    glm::vec2 mousePosition;
+    glm::vec2 mouseDelta;
+    glm::vec2 scrollDelta;
+    uint32_t mouseButtons;    // Bit 0 left, 1 right, 2 middle
+    uint32_t firstKeyEvent;   // Index into InputRecording::keyEvents
+    uint32_t keyEventCount;
+};
+
+struct RecordedKeyEvent {
+    int32_t key;
+    uint32_t pressed;
+};
+
+// Everything needed to reproduce a run: the scene parameters, the seed
+// shared by scene generation and gameplay randomness, and per-frame input.
+struct InputRecording {
+    static constexpr uint32_t VERSION = 1;
+    
+    uint64_t seed = 0;
+    uint32_t cubeCount = 0;
+    std::vector<InputFrame> frames;
+    std::vector<RecordedKeyEvent> keyEvents;
+    
+    void Clear() {
+        frames.clear();
+        keyEvents.clear();
+    }
+    
+    bool Save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) return false;
+        
+        uint64_t frameCount = frames.size();
+        uint64_t eventCount = keyEvents.size();
+        file.write(MAGIC, sizeof(MAGIC));
+        Write(file, VERSION);
+        Write(file, cubeCount);
+        Write(file, seed);
+        Write(file, frameCount);
+        Write(file, eventCount);
+        file.write(reinterpret_cast<const char*>(frames.data()), frameCount * sizeof(InputFrame));
+        file.write(reinterpret_cast<const char*>(keyEvents.data()), eventCount * sizeof(RecordedKeyEvent));
+        return static_cast<bool>(file);
+    }
+    
+    bool Load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        
+        char magic[sizeof(MAGIC)];
+        uint32_t version = 0;
+        uint64_t frameCount = 0, eventCount = 0;
+        file.read(magic, sizeof(magic));
+        Read(file, version);
+        if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) return false;
+        
+        Read(file, cubeCount);
+        Read(file, seed);
+        Read(file, frameCount);
+        Read(file, eventCount);
+        if (!file) return false;
+        
+        // Checked against what the file actually holds before anything is sized
+        std::streamoff dataStart = file.tellg();
+        file.seekg(0, std::ios::end);
+        uint64_t remaining = static_cast<uint64_t>(file.tellg() - dataStart);
+        file.seekg(dataStart);
+        if (!file || frameCount > remaining / sizeof(InputFrame) ||
+            eventCount > (remaining - frameCount * sizeof(InputFrame)) / sizeof(RecordedKeyEvent)) {
+            return false;
+        }
+        
+        frames.resize(frameCount);
+        keyEvents.resize(eventCount);
+        file.read(reinterpret_cast<char*>(frames.data()), frameCount * sizeof(InputFrame));
+        file.read(reinterpret_cast<char*>(keyEvents.data()), eventCount * sizeof(RecordedKeyEvent));
+        if (!file) return false;
+        
+        for (const auto& frame : frames) {
+            if (uint64_t(frame.firstKeyEvent) + frame.keyEventCount > eventCount) return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr char MAGIC[8] = { 'E', 'C', 'S', 'I', 'N', 'P', 'U', 'T' };
+    
+    template<typename T>
+    static void Write(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    
+    template<typename T>
+    static void Read(std::ifstream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+};
+
+}
+
+#endif
\ No newline at end of file
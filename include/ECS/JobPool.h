@@ -0,0 +1,175 @@
+#ifndef ECS_JOB_POOL_H
+#define ECS_JOB_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "AllocationCounter.h"
+
+namespace ECS {
+
+// Fixed set of worker threads for data-parallel loops. The calling thread
+// takes part in every ParallelFor, so a pool with N workers runs on N + 1
+// threads. Calls made from inside a job, or while another thread is already
+// dispatching, run inline instead of blocking.
+class JobPool {
+public:
+    explicit JobPool(unsigned threadCount = DefaultThreadCount()) {
+        for (unsigned i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+    
+    ~JobPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+    
+    // Total number of threads that can execute a ParallelFor, caller included
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+    
+    static unsigned DefaultThreadCount() {
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+    
+    static JobPool& Default() {
+        static JobPool pool;
+        return pool;
+    }
+    
+    // Calls func(begin, end) over [0, count) split into chunks of grainSize
+    template<typename Func>
+    void ParallelFor(size_t count, size_t grainSize, Func&& func) {
+        if (count == 0) return;
+        grainSize = std::max<size_t>(grainSize, 1);
+        size_t chunkCount = (count + grainSize - 1) / grainSize;
+        
+        if (workers.empty() || chunkCount == 1 || insideJob) {
+            func(size_t(0), count);
+            return;
+        }
+        
+        std::unique_lock<std::mutex> dispatch(dispatchMutex, std::try_to_lock);
+        if (!dispatch.owns_lock()) {
+            func(size_t(0), count);
+            return;
+        }
+        
+        using FuncType = std::remove_reference_t<Func>;
+        Batch batch;
+        batch.context = const_cast<void*>(static_cast<const void*>(&func));
+        batch.invoke = [](void* context, size_t begin, size_t end) {
+            (*static_cast<FuncType*>(context))(begin, end);
+        };
+        batch.count = count;
+        batch.grainSize = grainSize;
+        batch.chunkCount = chunkCount;
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &batch;
+            ++generation;
+        }
+        wakeCondition.notify_all();
+        
+        insideJob = true;
+        RunChunks(batch);
+        insideJob = false;
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [&] {
+            return busyWorkers == 0 && batch.completedChunks.load() == chunkCount;
+        });
+        current = nullptr;
+        AllocationCounter::Add(batch.workerAllocations.load(std::memory_order_relaxed));
+    }
+
+private:
+    struct Batch {
+        void* context = nullptr;
+        void (*invoke)(void*, size_t, size_t) = nullptr;
+        size_t count = 0;
+        size_t grainSize = 1;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> completedChunks{0};
+        std::atomic<uint64_t> workerAllocations{0};   // Made by workers, credited to the caller
+    };
+    
+    static void RunChunks(Batch& batch) {
+        for (;;) {
+            size_t chunk = batch.nextChunk.fetch_add(1);
+            if (chunk >= batch.chunkCount) break;
+            
+            size_t begin = chunk * batch.grainSize;
+            size_t end = std::min(begin + batch.grainSize, batch.count);
+            batch.invoke(batch.context, begin, end);
+            batch.completedChunks.fetch_add(1);
+        }
+    }
+    
+    void WorkerLoop() {
+        insideJob = true;
+        uint64_t seenGeneration = 0;
+        
+        for (;;) {
+            Batch* batch = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeCondition.wait(lock, [&] {
+                    return stopping || (current && generation != seenGeneration);
+                });
+                if (stopping) return;
+                
+                seenGeneration = generation;
+                batch = current;
+                ++busyWorkers;
+            }
+            
+            uint64_t allocationsStart = AllocationCounter::Get();
+            RunChunks(*batch);
+            uint64_t allocations = AllocationCounter::Get() - allocationsStart;
+            if (allocations) {
+                batch->workerAllocations.fetch_add(allocations, std::memory_order_relaxed);
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --busyWorkers;
+            }
+            doneCondition.notify_all();
+        }
+    }
+    
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::mutex dispatchMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    Batch* current = nullptr;
+    uint64_t generation = 0;
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+    
+    static inline thread_local bool insideJob = false;
+};
+
+}
+
+#endif
\ No newline at end of file
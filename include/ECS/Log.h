@@ -0,0 +1,293 @@
+#ifndef ECS_LOG_H
+#define ECS_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+
+// Messages below ECS_LOG_COMPILE_LEVEL are removed at compile time
+#define ECS_LOG_LEVEL_TRACE 0
+#define ECS_LOG_LEVEL_DEBUG 1
+#define ECS_LOG_LEVEL_INFO 2
+#define ECS_LOG_LEVEL_WARNING 3
+#define ECS_LOG_LEVEL_ERROR 4
+#define ECS_LOG_LEVEL_OFF 5
+
+#ifndef ECS_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define ECS_LOG_COMPILE_LEVEL ECS_LOG_LEVEL_INFO
+#else
+#define ECS_LOG_COMPILE_LEVEL ECS_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+namespace ECS {
+
+enum class LogLevel : uint8_t {
+    Trace = ECS_LOG_LEVEL_TRACE,
+    Debug = ECS_LOG_LEVEL_DEBUG,
+    Info = ECS_LOG_LEVEL_INFO,
+    Warning = ECS_LOG_LEVEL_WARNING,
+    Error = ECS_LOG_LEVEL_ERROR
+};
+
+constexpr size_t MAX_LOG_ARGS = 6;
+
+// A message is a static format string with "{}" placeholders plus up to
+// MAX_LOG_ARGS scalar arguments. Formatting happens on the drain thread, so
+// string arguments must be literals or otherwise outlive the log call.
+struct LogArg {
+    enum class Type : uint8_t { Int, UInt, Float, Bool, String };
+    
+    Type type;
+    union {
+        int64_t i;
+        uint64_t u;
+        double f;
+        bool b;
+        const char* s;
+    };
+};
+
+struct LogRecord {
+    LogLevel level;
+    uint8_t argCount;
+    uint64_t timestampUs;
+    const char* format;
+    LogArg args[MAX_LOG_ARGS];
+};
+
+// Lock-free multi-producer ring buffer drained by a background thread.
+// Producers never block: when the ring is full the record is dropped and
+// counted instead.
+class Logger {
+public:
+    static constexpr size_t CAPACITY = 4096;
+    
+    static Logger& Get() {
+        static Logger logger;
+        return logger;
+    }
+    
+    ~Logger() {
+        running.store(false);
+        if (drainThread.joinable()) {
+            drainThread.join();
+        }
+        Drain();
+    }
+    
+    void SetMinLevel(LogLevel level) { minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed); }
+    LogLevel GetMinLevel() const { return static_cast<LogLevel>(minLevel.load(std::memory_order_relaxed)); }
+    
+    uint64_t GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    
+    // A copy of a runtime string that stays valid until the process exits, for
+    // passing names to rare messages. Each distinct string is kept once.
+    static const char* Persist(std::string_view text) {
+        static std::mutex* mutex = new std::mutex();
+        static auto* strings = new std::unordered_set<std::string>();  // Never freed, so late drains can read it
+        std::lock_guard<std::mutex> lock(*mutex);
+        return strings->emplace(text).first->c_str();
+    }
+    
+    template<typename... Args>
+    void Write(LogLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= MAX_LOG_ARGS, "Too many log arguments");
+        if (static_cast<uint8_t>(level) < minLevel.load(std::memory_order_relaxed)) return;
+        
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & (CAPACITY - 1)];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        
+        LogRecord& record = slot->record;
+        record.level = level;
+        record.format = format;
+        record.timestampUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count());
+        record.argCount = 0;
+        (PackArg(record, args), ...);
+        
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+    
+    // Blocks until everything written so far has been printed
+    void Flush() {
+        size_t target = enqueuePos.load(std::memory_order_acquire);
+        while (dequeuePos.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+    
+    Logger() : startTime(std::chrono::steady_clock::now()) {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        drainThread = std::thread([this] {
+            while (running.load()) {
+                if (!Drain()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+        });
+    }
+    
+    template<typename T>
+    static void PackArg(LogRecord& record, const T& value) {
+        LogArg& arg = record.args[record.argCount++];
+        if constexpr (std::is_same_v<T, bool>) {
+            arg.type = LogArg::Type::Bool;
+            arg.b = value;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            arg.type = LogArg::Type::Int;
+            arg.i = value;
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            arg.type = LogArg::Type::UInt;
+            arg.u = static_cast<uint64_t>(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            arg.type = LogArg::Type::Float;
+            arg.f = value;
+        } else {
+            static_assert(std::is_convertible_v<T, const char*>,
+                "Log arguments must be scalars or string literals");
+            arg.type = LogArg::Type::String;
+            arg.s = value;
+        }
+    }
+    
+    static const char* LevelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::Trace: return "TRACE";
+            case LogLevel::Debug: return "DEBUG";
+            case LogLevel::Info: return "INFO";
+            case LogLevel::Warning: return "WARN";
+            case LogLevel::Error: return "ERROR";
+        }
+        return "?";
+    }
+    
+    static void AppendArg(std::string& out, const LogArg& arg) {
+        char buffer[32];
+        switch (arg.type) {
+            case LogArg::Type::Int: snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(arg.i)); break;
+            case LogArg::Type::UInt: snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(arg.u)); break;
+            case LogArg::Type::Float: snprintf(buffer, sizeof(buffer), "%g", arg.f); break;
+            case LogArg::Type::Bool: out += arg.b ? "true" : "false"; return;
+            case LogArg::Type::String: out += arg.s ? arg.s : "(null)"; return;
+        }
+        out += buffer;
+    }
+    
+    static void Format(std::string& out, const LogRecord& record) {
+        char prefix[48];
+        snprintf(prefix, sizeof(prefix), "[%10.3f] [%s] ",
+                 static_cast<double>(record.timestampUs) / 1000.0, LevelName(record.level));
+        out += prefix;
+        
+        size_t argIndex = 0;
+        for (const char* c = record.format; *c; ++c) {
+            if (c[0] == '{' && c[1] == '}' && argIndex < record.argCount) {
+                AppendArg(out, record.args[argIndex++]);
+                ++c;
+            } else {
+                out += *c;
+            }
+        }
+        out += '\n';
+    }
+    
+    // Single consumer; returns true if anything was printed
+    bool Drain() {
+        bool wrote = false;
+        for (;;) {
+            size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            Slot& slot = slots[pos & (CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+            
+            Format(line, slot.record);
+            slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+            dequeuePos.store(pos + 1, std::memory_order_release);
+            wrote = true;
+            
+            if (line.size() > 16 * 1024) {
+                fwrite(line.data(), 1, line.size(), stdout);
+                line.clear();
+            }
+        }
+        if (wrote) {
+            fwrite(line.data(), 1, line.size(), stdout);
+            fflush(stdout);
+            line.clear();
+        }
+        return wrote;
+    }
+    
+    Slot slots[CAPACITY];
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint8_t> minLevel{static_cast<uint8_t>(LogLevel::Trace)};
+    std::atomic<bool> running{true};
+    std::chrono::steady_clock::time_point startTime;
+    std::string line;
+    std::thread drainThread;
+};
+
+}
+
+#if ECS_LOG_COMPILE_LEVEL <= ECS_LOG_LEVEL_TRACE
+#define ECS_LOG_TRACE(...) ::ECS::Logger::Get().Write(::ECS::LogLevel::Trace, __VA_ARGS__)
+#else
+#define ECS_LOG_TRACE(...) ((void)0)
+#endif
+
+#if ECS_LOG_COMPILE_LEVEL <= ECS_LOG_LEVEL_DEBUG
+#define ECS_LOG_DEBUG(...) ::ECS::Logger::Get().Write(::ECS::LogLevel::Debug, __VA_ARGS__)
+#else
+#define ECS_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if ECS_LOG_COMPILE_LEVEL <= ECS_LOG_LEVEL_INFO
+#define ECS_LOG_INFO(...) ::ECS::Logger::Get().Write(::ECS::LogLevel::Info, __VA_ARGS__)
+#else
+#define ECS_LOG_INFO(...) ((void)0)
+#endif
+
+#if ECS_LOG_COMPILE_LEVEL <= ECS_LOG_LEVEL_WARNING
+#define ECS_LOG_WARNING(...) ::ECS::Logger::Get().Write(::ECS::LogLevel::Warning, __VA_ARGS__)
+#else
+#define ECS_LOG_WARNING(...) ((void)0)
+#endif
+
+#if ECS_LOG_COMPILE_LEVEL <= ECS_LOG_LEVEL_ERROR
+#define ECS_LOG_ERROR(...) ::ECS::Logger::Get().Write(::ECS::LogLevel::Error, __VA_ARGS__)
+#else
+#define ECS_LOG_ERROR(...) ((void)0)
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef ECS_PREFAB_H
+#define ECS_PREFAB_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Entity.h"
+#include "Component.h"
+#include "ComponentStorage.h"
+
+namespace ECS {
+
+// A set of components with default values. World::Instantiate copies it
+// into many new entities at once, appending to each component storage in
+// a single pass instead of one AddComponent call per entity and type.
+class Prefab {
+public:
+    template<typename T, typename... Args>
+    Prefab& Add(Args&&... args) {
+        static_assert(!std::is_empty_v<T>, "Empty types are marker tags; use AddTag");
+        static_assert(std::is_copy_constructible_v<T>, "Prefab components are copied into every instance");
+        
+        std::shared_ptr<const void> value;
+        if constexpr (std::is_constructible_v<T, Args...>) {
+            value = std::make_shared<T>(std::forward<Args>(args)...);
+        } else {
+            value = std::make_shared<T>(T{std::forward<Args>(args)...});
+        }
+        
+        Entry entry = {
+            Component::GetTypeId<T>(),
+            &ComponentTypeInfo::Of<StoredComponent<T>>(),
+            std::move(value),
+            &CopyInto<T>,
+            IsBoxedComponent<T>
+        };
+        auto it = std::find_if(entries.begin(), entries.end(),
+            [&entry](const Entry& e) { return e.typeId == entry.typeId; });
+        if (it != entries.end()) {
+            *it = std::move(entry);
+        } else {
+            entries.push_back(std::move(entry));
+        }
+        mask.set(Component::GetTypeId<T>());
+        return *this;
+    }
+    
+    template<typename T>
+    Prefab& AddTag() {
+        static_assert(std::is_empty_v<T>, "Marker tags must be empty types");
+        mask.set(Component::GetTypeId<T>());
+        return *this;
+    }
+    
+    template<typename T>
+    bool Has() const { return mask.test(Component::GetTypeId<T>()); }
+    
+    const std::bitset<MAX_COMPONENTS>& GetMask() const { return mask; }
+
+private:
+    friend class World;
+    
+    struct Entry {
+        uint32_t typeId;
+        const ComponentTypeInfo* storedType;   // To create the storage on first use
+        std::shared_ptr<const void> value;     // The default, a T
+        void (*copyInto)(void* firstSlot, size_t count, const void* value);
+        bool boxed;
+    };
+    
+    // Constructs count copies of the default into consecutive uninitialised slots
+    template<typename T>
+    static void CopyInto(void* firstSlot, size_t count, const void* value) {
+        const T& prototype = *static_cast<const T*>(value);
+        if constexpr (IsBoxedComponent<T>) {
+            auto* slots = static_cast<std::unique_ptr<Component>*>(firstSlot);
+            for (size_t i = 0; i < count; ++i) {
+                new (&slots[i]) std::unique_ptr<Component>(std::make_unique<T>(prototype));
+            }
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            // Doubling copies: log2(count) memcpy calls fill the whole range
+            auto* bytes = static_cast<std::byte*>(firstSlot);
+            std::memcpy(bytes, &prototype, sizeof(T));
+            for (size_t filled = 1; filled < count; ) {
+                size_t chunk = std::min(filled, count - filled);
+                std::memcpy(bytes + filled * sizeof(T), bytes, chunk * sizeof(T));
+                filled += chunk;
+            }
+        } else {
+            auto* slots = static_cast<T*>(firstSlot);
+            for (size_t i = 0; i < count; ++i) {
+                new (&slots[i]) T(prototype);
+            }
+        }
+    }
+    
+    std::vector<Entry> entries;
+    std::bitset<MAX_COMPONENTS> mask;
+};
+
+// One of the entities being created by World::Instantiate, handed to the
+// initializer. Get<T> reaches the new component directly, without a lookup;
+// T must be one of the prefab's components.
+class PrefabInstance {
+public:
+    size_t GetIndex() const { return index; }
+    const std::shared_ptr<Entity>& GetEntity() const { return entity; }
+    
+    template<typename T>
+    T& Get() const {
+        uint32_t typeId = Component::GetTypeId<T>();
+        void* slot = storages[typeId]->At(firstIndex[typeId] + index);
+        if constexpr (IsBoxedComponent<T>) {
+            return *static_cast<T*>(static_cast<std::unique_ptr<Component>*>(slot)->get());
+        } else {
+            return *static_cast<T*>(slot);
+        }
+    }
+
+private:
+    friend class World;
+    
+    PrefabInstance(ComponentStorage* const* storages, const uint32_t* firstIndex,
+                   size_t index, const std::shared_ptr<Entity>& entity)
+        : storages(storages), firstIndex(firstIndex), index(index), entity(entity) {}
+    
+    ComponentStorage* const* storages;   // Indexed by type id
+    const uint32_t* firstIndex;          // Storage index of the batch's first entity, by type id
+    size_t index;
+    const std::shared_ptr<Entity>& entity;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,279 @@
+#ifndef ECS_PROFILER_H
+#define ECS_PROFILER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+
+namespace ECS {
+
+enum class SystemPhase {
+    PreUpdate = 0,
+    Update = 1,
+    PostUpdate = 2
+};
+
+constexpr size_t SYSTEM_PHASE_COUNT = 3;
+
+struct PhaseTiming {
+    uint64_t startNs = 0;
+    uint64_t durationNs = 0;
+    uint32_t entityCount = 0;   // Entities returned by World queries in this phase
+    uint32_t allocations = 0;
+};
+
+struct SystemTiming {
+    size_t systemIndex = 0;
+    uint32_t nameId = 0;         // For FrameProfiler::GetSystemName
+    PhaseTiming phases[SYSTEM_PHASE_COUNT];
+    
+    uint64_t GetDurationNs() const {
+        return phases[0].durationNs + phases[1].durationNs + phases[2].durationNs;
+    }
+    uint32_t GetEntityCount() const {
+        return phases[0].entityCount + phases[1].entityCount + phases[2].entityCount;
+    }
+    uint32_t GetAllocations() const {
+        return phases[0].allocations + phases[1].allocations + phases[2].allocations;
+    }
+};
+
+struct FrameProfile {
+    uint64_t frameIndex = 0;
+    uint64_t startNs = 0;
+    uint64_t durationNs = 0;
+    uint32_t allocations = 0;
+    std::vector<SystemTiming> systems;
+};
+
+// Records per-system, per-phase timings for the most recent frames of a
+// World. Frame slots and their system lists are reused, and the World
+// reserves them as systems are added, so recording does not allocate.
+class FrameProfiler {
+public:
+    explicit FrameProfiler(size_t frameCapacity = 240)
+        : frames(frameCapacity), epoch(Clock::now()) {}
+    
+    // Sizes every frame slot up front, so recording never allocates mid-frame
+    void ReserveSystems(size_t systemCount) {
+        for (auto& frame : frames) {
+            frame.systems.reserve(systemCount);
+        }
+        if (systemNameIds.size() < systemCount) {
+            systemNameIds.resize(systemCount, NO_NAME);
+        }
+    }
+    
+    // Drops every recorded frame and name, e.g. when the World's systems go away
+    void Reset() {
+        for (auto& frame : frames) {
+            frame = FrameProfile{};
+        }
+        nextFrame = 0;
+        current = nullptr;
+        currentSystem = nullptr;
+        currentPhase = nullptr;
+        names.clear();
+        systemNameIds.clear();
+    }
+    
+    void SetEnabled(bool enable) { enabled = enable; }
+    bool IsEnabled() const { return enabled; }
+    
+    void BeginFrame() {
+        if (!enabled) return;
+        FrameProfile& frame = frames[nextFrame % frames.size()];
+        frame.frameIndex = nextFrame;
+        frame.systems.clear();
+        frame.allocations = 0;
+        frame.startNs = Now();
+        frameAllocationsStart = AllocationCounter::Get();
+        current = &frame;
+    }
+    
+    void EndFrame() {
+        if (!current) return;
+        current->durationNs = Now() - current->startNs;
+        current->allocations = static_cast<uint32_t>(AllocationCounter::Get() - frameAllocationsStart);
+        current = nullptr;
+        currentSystem = nullptr;
+        ++nextFrame;
+    }
+    
+    void BeginSystem(size_t systemIndex, const std::string& name) {
+        if (!current) return;
+        current->systems.emplace_back();
+        currentSystem = &current->systems.back();
+        currentSystem->systemIndex = systemIndex;
+        currentSystem->nameId = InternName(systemIndex, name);
+    }
+    
+    void EndSystem() { currentSystem = nullptr; }
+    
+    // A system in a fixed-rate group can run several times in one frame; its
+    // phases then add up, and startNs is that of the first run
+    void BeginPhase(SystemPhase phase) {
+        if (!currentSystem) return;
+        currentPhase = &currentSystem->phases[static_cast<size_t>(phase)];
+        phaseAllocationsStart = AllocationCounter::Get();
+        phaseStartNs = Now();
+        if (currentPhase->durationNs == 0) {
+            currentPhase->startNs = phaseStartNs;
+        }
+    }
+    
+    void EndPhase() {
+        if (!currentPhase) return;
+        currentPhase->durationNs += Now() - phaseStartNs;
+        currentPhase->allocations += static_cast<uint32_t>(AllocationCounter::Get() - phaseAllocationsStart);
+        currentPhase = nullptr;
+    }
+    
+    // Called by World queries so systems report their workload without extra code
+    void AddEntityCount(size_t count) {
+        if (currentPhase) currentPhase->entityCount += static_cast<uint32_t>(count);
+    }
+    
+    // The system's name when the timing was recorded; outlives the System
+    const std::string& GetSystemName(const SystemTiming& system) const { return names[system.nameId]; }
+    
+    // Number of completed frames currently held (at most the capacity)
+    size_t GetFrameCount() const { return nextFrame < frames.size() ? nextFrame : frames.size(); }
+    
+    // 0 is the most recently completed frame
+    const FrameProfile& GetFrame(size_t framesAgo) const {
+        return frames[(nextFrame - 1 - framesAgo) % frames.size()];
+    }
+    
+    // Mean wall time of a system across the recorded frames, in milliseconds
+    double GetAverageSystemTimeMs(size_t systemIndex) const {
+        uint64_t total = 0;
+        size_t samples = 0;
+        for (size_t i = 0; i < GetFrameCount(); ++i) {
+            for (const auto& system : GetFrame(i).systems) {
+                if (system.systemIndex == systemIndex) {
+                    total += system.GetDurationNs();
+                    samples++;
+                }
+            }
+        }
+        return samples ? static_cast<double>(total) / samples / 1e6 : 0.0;
+    }
+    
+    // Chrome trace event format; loads in chrome://tracing and ui.perfetto.dev
+    void WriteChromeTrace(std::ostream& out) const {
+        static const char* phaseNames[SYSTEM_PHASE_COUNT] = { "PreUpdate", "Update", "PostUpdate" };
+        
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        auto writeEvent = [&](const std::string& name, const char* category, uint64_t startNs,
+                              uint64_t durationNs, uint32_t entities, uint32_t allocations) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":";
+            WriteJsonString(out, name);
+            out << ",\"cat\":\"" << category
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+                << ",\"ts\":" << startNs / 1000.0
+                << ",\"dur\":" << durationNs / 1000.0
+                << ",\"args\":{\"entities\":" << entities
+                << ",\"allocations\":" << allocations << "}}";
+        };
+        
+        for (size_t i = GetFrameCount(); i-- > 0;) {
+            const FrameProfile& frame = GetFrame(i);
+            writeEvent("Frame " + std::to_string(frame.frameIndex), "frame",
+                       frame.startNs, frame.durationNs, 0, frame.allocations);
+            
+            for (const auto& system : frame.systems) {
+                std::string name = GetSystemName(system).empty() ? "System" : GetSystemName(system);
+                const PhaseTiming& firstPhase = system.phases[0];
+                const PhaseTiming& lastPhase = system.phases[SYSTEM_PHASE_COUNT - 1];
+                writeEvent(name, "system", firstPhase.startNs,
+                           lastPhase.startNs + lastPhase.durationNs - firstPhase.startNs,
+                           system.GetEntityCount(), system.GetAllocations());
+                
+                for (size_t p = 0; p < SYSTEM_PHASE_COUNT; ++p) {
+                    const PhaseTiming& phase = system.phases[p];
+                    writeEvent(name + "::" + phaseNames[p], "phase", phase.startNs,
+                               phase.durationNs, phase.entityCount, phase.allocations);
+                }
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+    
+    bool SaveChromeTrace(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) return false;
+        WriteChromeTrace(file);
+        return static_cast<bool>(file);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint32_t NO_NAME = UINT32_MAX;
+    
+    // Quoted and escaped, since system names are free-form
+    static void WriteJsonString(std::ostream& out, const std::string& text) {
+        static const char* hex = "0123456789abcdef";
+        out << '"';
+        for (char c : text) {
+            unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (u < 0x20) {
+                out << "\\u00" << hex[u >> 4] << hex[u & 0xF];
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+    
+    // Copies a name the first time it is seen. Each system index remembers its
+    // last id, so only a renamed or reordered system searches the table.
+    uint32_t InternName(size_t systemIndex, const std::string& name) {
+        if (systemIndex >= systemNameIds.size()) {
+            systemNameIds.resize(systemIndex + 1, NO_NAME);
+        }
+        uint32_t& cached = systemNameIds[systemIndex];
+        if (cached != NO_NAME && names[cached] == name) return cached;
+        
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it == names.end()) {
+            names.push_back(name);
+            it = names.end() - 1;
+        }
+        cached = static_cast<uint32_t>(it - names.begin());
+        return cached;
+    }
+    
+    uint64_t Now() const {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+    }
+    
+    std::vector<FrameProfile> frames;
+    std::vector<std::string> names;          // Interned system names, by nameId
+    std::vector<uint32_t> systemNameIds;     // Last nameId of each system index
+    Clock::time_point epoch;
+    size_t nextFrame = 0;
+    bool enabled = true;
+    
+    FrameProfile* current = nullptr;
+    SystemTiming* currentSystem = nullptr;
+    PhaseTiming* currentPhase = nullptr;
+    uint64_t frameAllocationsStart = 0;
+    uint64_t phaseAllocationsStart = 0;
+    uint64_t phaseStartNs = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef ECS_RESOURCE_H
+#define ECS_RESOURCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ECS {
+
+constexpr size_t MAX_RESOURCES = 64;
+
+// World-wide singletons (camera, timing, settings) held by the World outside
+// entity storage, one instance per type; see World::SetResource
+class Resource {
+public:
+    template<typename T>
+    static uint32_t GetTypeId() {
+        static uint32_t typeId = NextTypeId();
+        return typeId;
+    }
+
+private:
+    static uint32_t NextTypeId() {
+        static std::atomic<uint32_t> nextTypeId{0};
+        return nextTypeId++;
+    }
+};
+
+}
+
+#endif
\ No newline at end of file
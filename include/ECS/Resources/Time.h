@@ -0,0 +1,18 @@
+#ifndef ECS_TIME_H
+#define ECS_TIME_H
+
+#include <cstdint>
+
+namespace ECS {
+
+// Frame timing, kept up to date by World::Update. Systems in a fixed-rate
+// group get their step time as Update's deltaTime instead.
+struct Time {
+    float deltaTime = 0.0f;     // Of the current frame
+    double elapsed = 0.0;       // Sum of all frame times so far
+    uint64_t frameCount = 0;    // Frames started, including the current one
+};
+
+}
+
+#endif
\ No newline at end of file
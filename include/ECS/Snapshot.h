@@ -0,0 +1,108 @@
+#ifndef ECS_SNAPSHOT_H
+#define ECS_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "World.h"
+
+namespace ECS {
+
+// Binary world snapshot. The file is a header, a section table and one
+// section per component type; each section holds the owning entity indices
+// followed by a contiguous array of fixed-size records, both 16-byte
+// aligned so the records can be read in place from a memory mapping.
+// Entities are renumbered on load. Saved: Transform, Velocity, RigidBody
+// parameters, Collider, Renderable and Tag; entities with none of these are
+// left out.
+constexpr char SNAPSHOT_MAGIC[8] = { 'E', 'C', 'S', 'S', 'N', 'A', 'P', '\0' };
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+enum class SnapshotSection : uint32_t {
+    Transform = 1,
+    Velocity = 2,
+    RigidBody = 3,
+    Collider = 4,
+    Renderable = 5,
+    Tag = 6,
+    Strings = 7   // Character data referenced by TagRecord
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t entityCount;
+    uint64_t fileSize;
+};
+
+struct SnapshotSectionHeader {
+    uint32_t kind;
+    uint32_t recordSize;
+    uint64_t count;
+    uint64_t indexOffset;   // uint32_t entity index per record, 0 for Strings
+    uint64_t dataOffset;
+};
+
+struct TransformRecord {
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+};
+
+struct VelocityRecord {
+    glm::vec3 linear;
+    glm::vec3 angular;
+};
+
+// Bullet handles are runtime state; bodies are recreated by PhysicsSystem
+struct RigidBodyRecord {
+    float mass;
+    uint32_t type;
+    glm::vec3 linearVelocity;
+    glm::vec3 angularVelocity;
+    float linearDamping;
+    float angularDamping;
+    float friction;
+    float restitution;
+    uint32_t reportContacts;
+};
+
+struct ColliderRecord {
+    uint32_t type;
+    glm::vec3 size;
+    glm::vec3 offset;
+    float radius;
+    float height;
+};
+
+struct RenderableRecord {
+    uint32_t meshType;
+    glm::vec3 color;
+    uint32_t visible;
+    float opacity;
+};
+
+struct TagRecord {
+    uint32_t offset;
+    uint32_t length;
+};
+
+static_assert(std::is_trivially_copyable_v<TransformRecord> &&
+              std::is_trivially_copyable_v<VelocityRecord> &&
+              std::is_trivially_copyable_v<RigidBodyRecord> &&
+              std::is_trivially_copyable_v<ColliderRecord> &&
+              std::is_trivially_copyable_v<RenderableRecord> &&
+              std::is_trivially_copyable_v<TagRecord>,
+              "Snapshot records are read in place and must be trivially copyable");
+
+// Both return false on I/O errors; LoadSnapshot also rejects files with a
+// different version or out-of-range sections, leaving the world untouched.
+bool SaveSnapshot(const World& world, const std::string& path);
+bool LoadSnapshot(World& world, const std::string& path);
+
+}
+
+#endif
\ No newline at end of file
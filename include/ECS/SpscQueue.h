@@ -0,0 +1,57 @@
+#ifndef ECS_SPSC_QUEUE_H
+#define ECS_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace ECS {
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity must be a power of two; Push fails instead of blocking
+// when the queue is full.
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool Push(const T& item) {
+        size_t tail = tailPos.load(std::memory_order_relaxed);
+        if (tail - cachedHead == Capacity) {
+            cachedHead = headPos.load(std::memory_order_acquire);
+            if (tail - cachedHead == Capacity) return false;
+        }
+        items[tail & (Capacity - 1)] = item;
+        tailPos.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    bool Pop(T& item) {
+        size_t head = headPos.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailPos.load(std::memory_order_acquire);
+            if (head == cachedTail) return false;
+        }
+        item = items[head & (Capacity - 1)];
+        headPos.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Approximate when called concurrently with Push or Pop
+    size_t Size() const {
+        return tailPos.load(std::memory_order_acquire) - headPos.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[Capacity];
+    
+    // Each side keeps its own index and a cached copy of the other's on a
+    // separate cache line, so steady-state traffic touches one shared line
+    alignas(64) std::atomic<size_t> tailPos{0};
+    size_t cachedHead = 0;
+    alignas(64) std::atomic<size_t> headPos{0};
+    size_t cachedTail = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,16 +1,38 @@
 #ifndef ECS_SYSTEM_H
 #define ECS_SYSTEM_H
 
+#include <atomic>
 #include <vector>
 #include <bitset>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include "Entity.h"
 #include "Component.h"
+#include "Resource.h"
 
 namespace ECS {
 
 class World;
 
+// Systems that share a tick rate. With a rate, the group runs in fixed steps
+// of 1 / tickRate, as many each frame as the elapsed time covers (at most
+// maxStepsPerFrame). A rate of 0 runs once per frame with the frame's delta.
+struct SystemGroup {
+    std::string name;
+    float tickRate = 0.0f;
+    uint32_t maxStepsPerFrame = 4;
+    float accumulator = 0.0f;
+    uint32_t stepsThisFrame = 0;
+    
+    float GetStepTime(float frameDeltaTime) const {
+        return tickRate > 0.0f ? 1.0f / tickRate : frameDeltaTime;
+    }
+    
+    // How far the group is into its next step, for interpolating between steps
+    float GetAlpha() const { return tickRate > 0.0f ? accumulator * tickRate : 1.0f; }
+};
+
 class System {
 public:
     System() : priority(0), enabled(true) {}
@@ -20,15 +42,72 @@ public:
     virtual void PreUpdate(float deltaTime) {}
     virtual void PostUpdate(float deltaTime) {}
     
+    // Called by World::AddSystem once the world is set; register observers here
+    virtual void OnAddedToWorld() {}
+    
+    // Called once per DestroyEntities batch, before the entities' components
+    // are removed, so systems holding external state can release it in bulk
+    virtual void OnEntitiesDestroyed(const EntityList& entities) {}
+    
+    // Dense id per system type, for the World's system registry
+    template<typename T>
+    static uint32_t GetTypeId() {
+        static uint32_t typeId = NextTypeId();
+        return typeId;
+    }
+    
     void SetWorld(World* world) { this->world = world; }
     World* GetWorld() const { return world; }
     
     void SetEnabled(bool enable) { enabled = enable; }
     bool IsEnabled() const { return enabled; }
     
+    void SetName(const std::string& systemName) { name = systemName; }
+    const std::string& GetName() const { return name; }
+    
     void SetPriority(int p) { priority = p; }
     int GetPriority() const { return priority; }
     
+    // World change tick at which this system last finished updating
+    void SetLastRunTick(uint32_t tick) { lastRunTick = tick; }
+    uint32_t GetLastRunTick() const { return lastRunTick; }
+    
+    // Group whose tick rate decides how often this system runs (see
+    // World::AddSystemGroup). Systems without a group run once per frame.
+    void SetGroup(const std::string& groupName) { group = groupName; }
+    const std::string& GetGroup() const { return group; }
+    
+    // Spreads per-entity work over several runs: each run handles the
+    // entities whose id falls in the current bucket, so every entity is
+    // visited once per `count` runs.
+    void SetStaggerBuckets(uint32_t count) {
+        staggerBuckets = count > 1 ? count : 1;
+        staggerBucket = staggerBuckets - 1;
+        staggerElapsed.assign(staggerBuckets, 0.0f);
+    }
+    uint32_t GetStaggerBuckets() const { return staggerBuckets; }
+    uint32_t GetStaggerBucket() const { return staggerBucket; }
+    
+    bool IsInStaggerBucket(const Entity& entity) const {
+        return staggerBuckets == 1 || entity.GetId() % staggerBuckets == staggerBucket;
+    }
+    
+    // Time since the current bucket was last handled, to use in place of
+    // deltaTime for its entities
+    float GetStaggerDeltaTime() const { return staggerDeltaTime; }
+    
+    // World resources this system reads or writes, as declared with
+    // ReadsResources/WritesResources
+    const std::bitset<MAX_RESOURCES>& GetResourceReads() const { return resourceReads; }
+    const std::bitset<MAX_RESOURCES>& GetResourceWrites() const { return resourceWrites; }
+    
+    // True if the two systems cannot run side by side: one writes a resource
+    // the other reads or writes. For a scheduler deciding what may overlap.
+    bool HasResourceConflict(const System& other) const {
+        return (resourceWrites & (other.resourceReads | other.resourceWrites)).any() ||
+               (other.resourceWrites & resourceReads).any();
+    }
+    
     bool MatchesEntity(const Entity& entity) const {
         if (!enabled || requiredComponents.none()) {
             return false;
@@ -47,10 +126,73 @@ protected:
         (requiredComponents.set(Component::GetTypeId<Components>()), ...);
     }
     
+    // Debug builds warn when a system uses a resource it did not declare
+    template<typename... Resources>
+    void ReadsResources() {
+        (resourceReads.set(Resource::GetTypeId<Resources>()), ...);
+    }
+    
+    template<typename... Resources>
+    void WritesResources() {
+        (resourceWrites.set(Resource::GetTypeId<Resources>()), ...);
+    }
+    
+    // Points slot at the world's T system, so Update can use it without a
+    // lookup. The World fills it in when this system is added, and again
+    // whenever another system is added; it stays null while no T exists.
+    template<typename T>
+    void DependsOn(T*& slot) {
+        static_assert(std::is_base_of_v<System, T>, "Dependencies are systems");
+        dependencies.push_back({GetTypeId<T>(), &slot, [](void* slot, System* candidate) {
+            T* resolved = dynamic_cast<T*>(candidate);
+            *static_cast<T**>(slot) = resolved;
+            return resolved != nullptr;
+        }});
+    }
+    
     World* world = nullptr;
     std::bitset<MAX_COMPONENTS> requiredComponents;
     int priority;
     bool enabled;
+    uint32_t lastRunTick = 0;
+    std::string name;
+
+private:
+    friend class World;
+    
+    struct Dependency {
+        uint32_t typeId;
+        void* slot;                                   // A T**
+        bool (*assign)(void* slot, System* candidate); // Sets the slot if candidate is a T
+    };
+    
+    static uint32_t NextTypeId() {
+        static std::atomic<uint32_t> nextTypeId{0};
+        return nextTypeId++;
+    }
+    
+    // Called by the World before each run
+    void AdvanceStagger(float deltaTime) {
+        staggerDeltaTime = deltaTime;
+        if (staggerBuckets == 1) return;
+        staggerBucket = (staggerBucket + 1) % staggerBuckets;
+        for (float& elapsed : staggerElapsed) {
+            elapsed += deltaTime;
+        }
+        staggerDeltaTime = staggerElapsed[staggerBucket];
+        staggerElapsed[staggerBucket] = 0.0f;
+    }
+    
+    std::string group;
+    size_t groupIndex = 0;               // Resolved from group by the World
+    uint32_t staggerBuckets = 1;
+    uint32_t staggerBucket = 0;
+    float staggerDeltaTime = 0.0f;
+    std::vector<float> staggerElapsed;   // Per bucket, time since it last ran
+    std::vector<Dependency> dependencies;
+    std::bitset<MAX_RESOURCES> resourceReads;
+    std::bitset<MAX_RESOURCES> resourceWrites;
+    std::bitset<MAX_RESOURCES> undeclaredResourcesReported;
 };
 
 }
@@ -27,8 +27,12 @@ public:
         auto entities = world->GetEntitiesWithComponents(mask);
         
         for (auto& entity : entities) {
+            // Only take mutable access when clamping, so in-bounds entities
+            // do not show up as changed
+            const auto* current = world->ReadComponent<Transform>(entity);
+            if (!current || IsInside(current->position)) continue;
+            
             auto* transform = world->GetComponent<Transform>(entity);
-            if (!transform) continue;
             
             auto* velocity = world->GetComponent<Velocity>(entity);
             
@@ -56,6 +60,14 @@ public:
             }
         }
     }
+
+private:
+    bool IsInside(const glm::vec3& position) const {
+        for (int i = 0; i < 3; ++i) {
+            if (position[i] < minBounds[i] || position[i] > maxBounds[i]) return false;
+        }
+        return true;
+    }
 };
 
 }
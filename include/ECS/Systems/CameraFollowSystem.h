@@ -0,0 +1,41 @@
+#ifndef ECS_CAMERA_FOLLOW_SYSTEM_H
+#define ECS_CAMERA_FOLLOW_SYSTEM_H
+
+#include <glm/glm.hpp>
+#include "../System.h"
+#include "../World.h"
+#include "../Components/Transform.h"
+#include "../Components/Tag.h"
+#include "../../Camera.h"
+
+namespace ECS {
+
+// Keeps the world's Camera resource behind and above the player
+class CameraFollowSystem : public System {
+public:
+    float distance = 10.0f;
+    float height = 5.0f;
+    
+    CameraFollowSystem() {
+        RequireComponents<Transform, Tag>();
+        SetPriority(96); // After the transform hierarchy, before render
+        WritesResources<Camera>();
+    }
+    
+    void Update(float deltaTime) override {
+        auto* camera = world->GetResource<Camera>();
+        auto player = world->FindEntityWithTag(Tags::Player);
+        if (!camera || !player) return;
+        
+        const auto* transform = world->ReadComponent<Transform>(player);
+        if (!transform) return;
+        
+        glm::vec3 cameraOffset = transform->position - transform->GetForward() * distance + glm::vec3(0, height, 0);
+        camera->Position = cameraOffset;
+        camera->Front = glm::normalize(transform->position - cameraOffset);
+    }
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+#ifndef ECS_DEMO_CONTROL_SYSTEM_H
+#define ECS_DEMO_CONTROL_SYSTEM_H
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../System.h"
+#include "../World.h"
+#include "../Log.h"
+#include "../Components/Transform.h"
+#include "../Components/Velocity.h"
+#include "../Components/Renderable.h"
+#include "../Components/Input.h"
+#include "../Components/Tag.h"
+#include "../Components/RigidBody.h"
+#include "../Components/Collider.h"
+#include "PhysicsSystem.h"
+
+namespace ECS {
+
+// The demo's number-key actions (spawn, remove, spin, gravity, impulse,
+// reset), driven by the player's Input and a seeded generator so a run
+// replays identically from recorded input.
+class DemoControlSystem : public System {
+public:
+    bool cubeSpin = true;
+    
+    explicit DemoControlSystem(uint32_t seed) : rng(seed) {
+        RequireComponents<Transform, Input, Tag>();
+        SetPriority(-40); // After the player controller, before movement and physics
+        
+        auto rb = RigidBody(1.0f, RigidBodyType::Dynamic);
+        rb.angularVelocity = glm::vec3(1.0f, 2.0f, 0.5f);
+        rb.friction = 0.4f;
+        rb.restitution = 0.6f;
+        spawnedCubePrefab.Add<Transform>()
+                         .Add<RigidBody>(rb)
+                         .Add<Collider>(Collider::Box(glm::vec3(1.0f)))
+                         .Add<Renderable>(MeshType::Cube, glm::vec3(1.0f, 0.0f, 1.0f))
+                         .Add<Tag>("Spawned");
+        DependsOn(physics);
+    }
+    
+    void Update(float deltaTime) override {
+        auto player = world->FindEntityWithTag(Tags::Player);
+        const auto* input = player ? world->ReadComponent<Input>(player) : nullptr;
+        
+        if (input && physics) {
+            if (input->IsKeyPressed(Key::Num1)) SpawnCube(player);
+            if (input->IsKeyPressed(Key::Num2)) RemoveRandomCube();
+            if (input->IsKeyPressed(Key::Num3)) {
+                cubeSpin = !cubeSpin;
+                ECS_LOG_INFO("Cube spin: {}", cubeSpin ? "ON" : "OFF");
+            }
+            if (input->IsKeyPressed(Key::Num4)) {
+                bool gravityEnabled = physics->IsGravityEnabled();
+                physics->EnableGravity(!gravityEnabled);
+                ECS_LOG_INFO("Gravity: {}", !gravityEnabled ? "ON" : "OFF");
+            }
+            if (input->IsKeyPressed(Key::Num5)) ApplyRandomImpulses();
+            if (input->IsKeyPressed(Key::Num6)) ResetCubes();
+        }
+        
+        if (physics) {
+            ApplySpin();
+        }
+    }
+
+private:
+    EntityList FindCubes() {
+        const auto& cubes = world->GetEntitiesWithTag(Tags::Cube);
+        const auto& spawned = world->GetEntitiesWithTag(Tags::Spawned);
+        EntityList result(world->GetFrameAllocator<std::shared_ptr<Entity>>());
+        result.reserve(cubes.size() + spawned.size());
+        result.insert(result.end(), cubes.begin(), cubes.end());
+        result.insert(result.end(), spawned.begin(), spawned.end());
+        return result;
+    }
+    
+    void SpawnCube(const std::shared_ptr<Entity>& player) {
+        const auto* playerTransform = world->ReadComponent<Transform>(player);
+        if (!playerTransform) return;
+        
+        // Copied, since instantiating can move the player's Transform
+        glm::vec3 position = playerTransform->position;
+        glm::vec3 forward = playerTransform->GetForward();
+        world->Instantiate(spawnedCubePrefab, 1, [&](PrefabInstance& cube) {
+            cube.Get<Transform>().position = position + forward * 3.0f;
+            cube.Get<RigidBody>().linearVelocity = forward * 10.0f;
+        });
+        ECS_LOG_INFO("Spawned new cube!");
+    }
+    
+    void RemoveRandomCube() {
+        auto cubes = FindCubes();
+        if (cubes.empty()) return;
+        
+        std::uniform_int_distribution<size_t> cubeDist(0, cubes.size() - 1);
+        auto cubeToRemove = cubes[cubeDist(rng)];
+        
+        // PhysicsSystem releases the body when the entity is destroyed
+        world->DestroyEntity(cubeToRemove);
+        ECS_LOG_INFO("Removed a cube! ({} remaining)", cubes.size() - 1);
+    }
+    
+    void ApplyRandomImpulses() {
+        std::uniform_int_distribution<int> horizontal(-10, 9);
+        std::uniform_int_distribution<int> vertical(5, 14);
+        
+        int count = 0;
+        for (auto& entity : FindCubes()) {
+            const auto* rb = world->ReadComponent<RigidBody>(entity);
+            if (rb && rb->bulletBody) {
+                glm::vec3 impulse(horizontal(rng) * 20.0f, vertical(rng) * 30.0f, horizontal(rng) * 20.0f);
+                physics->ApplyImpulse(entity, impulse);
+                count++;
+            } else {
+                ECS_LOG_WARNING("Cube {} has no physics body!", entity->GetId());
+            }
+        }
+        ECS_LOG_INFO("Applied random impulse to {} cubes!", count);
+    }
+    
+    void ResetCubes() {
+        std::uniform_int_distribution<int> spread(-40, 39);
+        
+        for (auto& entity : FindCubes()) {
+            const auto* rb = world->ReadComponent<RigidBody>(entity);
+            if (!rb || !rb->bulletBody || !world->HasComponent<Transform>(entity)) continue;
+            
+            auto* transform = world->GetComponent<Transform>(entity);
+            transform->position.y = std::abs(transform->position.y) + 15.0f;
+            transform->position.x = spread(rng) * 0.5f;
+            transform->position.z = spread(rng) * 0.5f;
+            physics->SyncTransformToBullet(entity);
+            physics->SetLinearVelocity(entity, glm::vec3(0.0f));
+            physics->SetAngularVelocity(entity, glm::vec3(0.0f));
+        }
+        ECS_LOG_INFO("Reset all cube positions!");
+    }
+    
+    void ApplySpin() {
+        glm::vec3 spin = cubeSpin ? glm::vec3(0.5f, 1.0f, 0.2f) : glm::vec3(0.0f);
+        
+        for (auto& entity : FindCubes()) {
+            const auto* rb = world->ReadComponent<RigidBody>(entity);
+            if (rb && rb->bulletBody) {
+                physics->SetAngularVelocity(entity, spin);
+            } else if (cubeSpin && !world->HasComponent<Velocity>(entity)) {
+                // Non-physics cubes spin through MovementSystem instead
+                world->AddComponent<Velocity>(entity, Velocity(glm::vec3(0.0f), spin));
+            }
+        }
+    }
+    
+    std::mt19937 rng;
+    Prefab spawnedCubePrefab;
+    PhysicsSystem* physics = nullptr;
+};
+
+}
+
+#endif
\ No newline at end of file
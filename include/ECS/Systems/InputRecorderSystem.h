@@ -0,0 +1,64 @@
+#ifndef ECS_INPUT_RECORDER_SYSTEM_H
+#define ECS_INPUT_RECORDER_SYSTEM_H
+
+#include "../System.h"
+#include "../World.h"
+#include "../InputRecording.h"
+#include "../Components/Input.h"
+
+namespace ECS {
+
+// Captures the first Input entity's state every frame, after InputSystem
+// has filled it in and before anything consumes it.
+class InputRecorderSystem : public System {
+public:
+    explicit InputRecorderSystem(InputRecording* recording) : recording(recording) {
+        RequireComponents<Input>();
+        SetPriority(-99); // Right after InputSystem
+    }
+    
+    void Update(float deltaTime) override {
+        std::bitset<MAX_COMPONENTS> mask;
+        mask.set(Component::GetTypeId<Input>());
+        auto entities = world->GetEntitiesWithComponents(mask);
+        
+        InputFrame frame = {};
+        frame.deltaTime = deltaTime;
+        frame.firstKeyEvent = static_cast<uint32_t>(recording->keyEvents.size());
+        
+        if (!entities.empty()) {
+            const auto* input = world->ReadComponent<Input>(entities.front());
+            frame.mousePosition = input->mousePosition;
+            frame.mouseDelta = input->mouseDelta;
+            frame.scrollDelta = input->scrollDelta;
+            for (uint32_t i = 0; i < 3; ++i) {
+                if (input->mouseButtons[i]) frame.mouseButtons |= 1u << i;
+            }
+            
+            // Edges rather than levels, so taps shorter than a frame survive.
+            // A key that ends the frame down was released before it was pressed.
+            auto edges = input->keysPressed | input->keysReleased;
+            for (int key = 0; edges.any() && key < Input::MAX_KEYS; ++key) {
+                if (!edges.test(key)) continue;
+                edges.reset(key);
+                
+                bool pressed = input->keysPressed.test(key);
+                bool released = input->keysReleased.test(key);
+                bool down = input->keysDown.test(key);
+                if (released && (!pressed || down)) recording->keyEvents.push_back({key, 0u});
+                if (pressed) recording->keyEvents.push_back({key, 1u});
+                if (released && pressed && !down) recording->keyEvents.push_back({key, 0u});
+            }
+        }
+        
+        frame.keyEventCount = static_cast<uint32_t>(recording->keyEvents.size()) - frame.firstKeyEvent;
+        recording->frames.push_back(frame);
+    }
+
+private:
+    InputRecording* recording;
+};
+
+}
+
+#endif
\ No newline at end of file
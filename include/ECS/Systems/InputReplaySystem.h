@@ -0,0 +1,65 @@
+#ifndef ECS_INPUT_REPLAY_SYSTEM_H
+#define ECS_INPUT_REPLAY_SYSTEM_H
+
+#include "../System.h"
+#include "../World.h"
+#include "../InputRecording.h"
+#include "../Components/Input.h"
+
+namespace ECS {
+
+// Feeds a recording back into every Input entity, one frame per
+// World::Update, in InputSystem's place. Drive the world with
+// GetNextDeltaTime() to reproduce the recorded frame timing.
+class InputReplaySystem : public System {
+public:
+    explicit InputReplaySystem(const InputRecording* recording) : recording(recording) {
+        RequireComponents<Input>();
+        SetPriority(-100); // Run first, like InputSystem
+    }
+    
+    bool IsFinished() const { return frameIndex >= recording->frames.size(); }
+    size_t GetFrameIndex() const { return frameIndex; }
+    
+    float GetNextDeltaTime() const {
+        return IsFinished() ? 0.0f : recording->frames[frameIndex].deltaTime;
+    }
+    
+    void Update(float deltaTime) override {
+        if (IsFinished()) return;
+        const InputFrame& frame = recording->frames[frameIndex];
+        
+        std::bitset<MAX_COMPONENTS> mask;
+        mask.set(Component::GetTypeId<Input>());
+        auto entities = world->GetEntitiesWithComponents(mask);
+        
+        for (auto& entity : entities) {
+            auto* input = world->GetComponent<Input>(entity);
+            if (!input) continue;
+            
+            input->BeginFrame();
+            for (uint32_t i = 0; i < frame.keyEventCount; ++i) {
+                const RecordedKeyEvent& event = recording->keyEvents[frame.firstKeyEvent + i];
+                input->UpdateKey(event.key, event.pressed != 0);
+            }
+            input->mousePosition = frame.mousePosition;
+            input->mouseDelta = frame.mouseDelta;
+            input->scrollDelta = frame.scrollDelta;
+            for (uint32_t b = 0; b < 3; ++b) {
+                input->mouseButtons[b] = (frame.mouseButtons >> b) & 1u;
+            }
+        }
+    }
+    
+    void PostUpdate(float deltaTime) override {
+        if (!IsFinished()) frameIndex++;
+    }
+
+private:
+    const InputRecording* recording;
+    size_t frameIndex = 0;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,24 +1,86 @@
 #ifndef ECS_INPUT_SYSTEM_H
 #define ECS_INPUT_SYSTEM_H
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
 #include <GLFW/glfw3.h>
 #include "../System.h"
+#include "../World.h"
+#include "../Log.h"
+#include "../SpscQueue.h"
 #include "../Components/Input.h"
 
 namespace ECS {
 
+struct InputEvent {
+    enum class Type : uint8_t { Key, MouseButton, CursorPos, Scroll };
+    
+    Type type;
+    bool pressed;
+    int code;     // Key code or mouse button
+    float x;      // Cursor position or scroll offset
+    float y;
+};
+
+// GLFW callbacks push events into a lock-free queue; Update drains it once
+// per frame and applies the events in order to every Input entity, so only
+// keys that actually changed are touched. The window's user pointer must be
+// the World this system belongs to; the callbacks find the system through it.
 class InputSystem : public System {
 public:
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
+    
     InputSystem(GLFWwindow* window) : window(window), firstMouse(true) {
         RequireComponents<Input>();
         SetPriority(-100); // Run first
         
         lastMouseX = 0.0f;
         lastMouseY = 0.0f;
+        
+        // Scroll stays with the application's callback, which forwards it
+        // through AddScroll alongside its own handling
+        if (window) {
+            glfwSetKeyCallback(window, KeyCallback);
+            glfwSetMouseButtonCallback(window, MouseButtonCallback);
+            glfwSetCursorPosCallback(window, CursorPosCallback);
+        }
+    }
+    
+    ~InputSystem() {
+        if (window) {
+            glfwSetKeyCallback(window, nullptr);
+            glfwSetMouseButtonCallback(window, nullptr);
+            glfwSetCursorPosCallback(window, nullptr);
+        }
     }
     
     void Update(float deltaTime) override {
-        if (!window) return;
+        frameEvents.clear();
+        glm::vec2 mouseDelta(0.0f);
+        glm::vec2 scroll(0.0f);
+        
+        InputEvent event;
+        while (events.Pop(event)) {
+            if (event.type == InputEvent::Type::CursorPos) {
+                if (firstMouse) {
+                    lastMouseX = event.x;
+                    lastMouseY = event.y;
+                    firstMouse = false;
+                }
+                mouseDelta += glm::vec2(event.x - lastMouseX, lastMouseY - event.y); // Y reversed
+                lastMouseX = event.x;
+                lastMouseY = event.y;
+            } else if (event.type == InputEvent::Type::Scroll) {
+                scroll += glm::vec2(event.x, event.y);
+            } else {
+                frameEvents.push_back(event);
+            }
+        }
+        
+        if (uint64_t dropped = droppedEvents.exchange(0, std::memory_order_relaxed)) {
+            ECS_LOG_WARNING("InputSystem: event queue full, dropped {} events", dropped);
+        }
         
         std::bitset<MAX_COMPONENTS> mask;
         mask.set(Component::GetTypeId<Input>());
@@ -28,88 +90,64 @@ public:
             auto* input = world->GetComponent<Input>(entity);
             if (!input) continue;
             
-            // Update keyboard state
-            UpdateKeyboardState(input);
-            
-            // Update mouse state
-            UpdateMouseState(input);
-            
-            // Update scroll (handled via callback)
+            input->BeginFrame();
+            for (const auto& e : frameEvents) {
+                if (e.type == InputEvent::Type::Key) {
+                    input->UpdateKey(e.code, e.pressed);
+                } else if (e.code >= 0 && e.code < 3) {
+                    input->mouseButtons[e.code] = e.pressed;
+                }
+            }
+            input->mousePosition = glm::vec2(lastMouseX, lastMouseY);
+            input->mouseDelta = mouseDelta;
+            input->scrollDelta = scroll;
         }
     }
     
-    void PostUpdate(float deltaTime) override {
-        std::bitset<MAX_COMPONENTS> mask;
-        mask.set(Component::GetTypeId<Input>());
-        auto entities = world->GetEntitiesWithComponents(mask);
-        
-        for (auto& entity : entities) {
-            auto* input = world->GetComponent<Input>(entity);
-            if (input) {
-                input->EndFrame();
-            }
+    // Producer side; safe to call from the thread that polls window events
+    void PushEvent(const InputEvent& event) {
+        if (!events.Push(event)) {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
         }
     }
     
-    void SetScrollDelta(float xoffset, float yoffset) {
-        scrollX = xoffset;
-        scrollY = yoffset;
+    void AddScroll(float xoffset, float yoffset) {
+        PushEvent({InputEvent::Type::Scroll, false, 0, xoffset, yoffset});
     }
-    
+
 private:
-    void UpdateKeyboardState(Input* input) {
-        // Common game keys
-        int keysToCheck[] = {
-            GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D,
-            GLFW_KEY_SPACE, GLFW_KEY_LEFT_SHIFT, GLFW_KEY_LEFT_CONTROL,
-            GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_LEFT, GLFW_KEY_RIGHT,
-            GLFW_KEY_ESCAPE, GLFW_KEY_ENTER, GLFW_KEY_TAB,
-            GLFW_KEY_Q, GLFW_KEY_E, GLFW_KEY_R, GLFW_KEY_F,
-            GLFW_KEY_1, GLFW_KEY_2, GLFW_KEY_3, GLFW_KEY_4, GLFW_KEY_5, GLFW_KEY_6
-        };
-        
-        for (int key : keysToCheck) {
-            bool pressed = glfwGetKey(window, key) == GLFW_PRESS;
-            input->UpdateKey(key, pressed);
+    static InputSystem* FromWindow(GLFWwindow* window) {
+        auto* world = static_cast<World*>(glfwGetWindowUserPointer(window));
+        return world ? world->GetSystem<InputSystem>() : nullptr;
+    }
+    
+    static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+        if (action == GLFW_REPEAT) return;
+        if (auto* system = FromWindow(window)) {
+            system->PushEvent({InputEvent::Type::Key, action == GLFW_PRESS, key, 0.0f, 0.0f});
         }
     }
     
-    void UpdateMouseState(Input* input) {
-        double xpos, ypos;
-        glfwGetCursorPos(window, &xpos, &ypos);
-        
-        if (firstMouse) {
-            lastMouseX = static_cast<float>(xpos);
-            lastMouseY = static_cast<float>(ypos);
-            firstMouse = false;
+    static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+        if (auto* system = FromWindow(window)) {
+            system->PushEvent({InputEvent::Type::MouseButton, action == GLFW_PRESS, button, 0.0f, 0.0f});
+        }
+    }
+    
+    static void CursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
+        if (auto* system = FromWindow(window)) {
+            system->PushEvent({InputEvent::Type::CursorPos, false, 0,
+                               static_cast<float>(xpos), static_cast<float>(ypos)});
         }
-        
-        float deltaX = static_cast<float>(xpos) - lastMouseX;
-        float deltaY = lastMouseY - static_cast<float>(ypos); // Reversed
-        
-        input->mousePosition = glm::vec2(xpos, ypos);
-        input->mouseDelta = glm::vec2(deltaX, deltaY);
-        input->scrollDelta = glm::vec2(scrollX, scrollY);
-        
-        lastMouseX = static_cast<float>(xpos);
-        lastMouseY = static_cast<float>(ypos);
-        
-        // Mouse buttons
-        input->mouseButtons[0] = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-        input->mouseButtons[1] = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
-        input->mouseButtons[2] = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_MIDDLE) == GLFW_PRESS;
-        
-        // Reset scroll for next frame
-        scrollX = 0.0f;
-        scrollY = 0.0f;
     }
     
     GLFWwindow* window;
     bool firstMouse;
     float lastMouseX;
     float lastMouseY;
-    float scrollX = 0.0f;
-    float scrollY = 0.0f;
+    SpscQueue<InputEvent, EVENT_QUEUE_CAPACITY> events;
+    std::atomic<uint64_t> droppedEvents{0};
+    std::vector<InputEvent> frameEvents;
 };
 
 }
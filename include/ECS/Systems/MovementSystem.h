@@ -23,14 +23,14 @@ public:
         auto entities = world->GetEntitiesWithComponents(mask);
         
         for (auto& entity : entities) {
-            auto* rb = world->GetComponent<RigidBody>(entity);
+            const auto* rb = world->ReadComponent<RigidBody>(entity);
             
             if (rb && rb->bulletBody) {
                 continue;
             }
             
             auto* transform = world->GetComponent<Transform>(entity);
-            auto* velocity = world->GetComponent<Velocity>(entity);
+            const auto* velocity = world->ReadComponent<Velocity>(entity);
             
             if (!transform || !velocity) continue;
             
@@ -1,16 +1,108 @@
 #ifndef ECS_PHYSICS_SYSTEM_H
 #define ECS_PHYSICS_SYSTEM_H
 
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <btBulletDynamicsCommon.h>
 #include "../System.h"
+#include "../World.h"
 #include "../Components/Transform.h"
 #include "../Components/RigidBody.h"
 #include "../Components/Collider.h"
+#include "../Events/ContactEvents.h"
+#include "../JobPool.h"
 
 namespace ECS {
 
+struct RaycastQuery {
+    glm::vec3 from;
+    glm::vec3 to;
+    uint32_t ignoreEntity = 0;  // 0 hits everything
+};
+
+struct SweepQuery {
+    Collider shape;  // Box, Sphere or Capsule
+    glm::vec3 from;
+    glm::vec3 to;
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    uint32_t ignoreEntity = 0;
+};
+
+struct OverlapQuery {
+    Collider shape;
+    glm::vec3 position;
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+};
+
+struct QueryHit {
+    bool hit;
+    uint32_t entity;
+    glm::vec3 point;
+    glm::vec3 normal;
+    float fraction;
+};
+
+// Fixed-capacity overlap results: query i owns
+// entities[i * maxHitsPerQuery, i * maxHitsPerQuery + counts[i])
+struct OverlapResults {
+    size_t maxHitsPerQuery = 16;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> entities;
+    
+    uint32_t GetCount(size_t query) const { return counts[query]; }
+    const uint32_t* GetHits(size_t query) const { return entities.data() + query * maxHitsPerQuery; }
+};
+
+// Collision shapes shared by every body whose collider has the same
+// dimensions. Bullet treats shapes as read-only while stepping, so one
+// library can serve the PhysicsSystems of many worlds on different threads.
+// Shapes live until the library is destroyed. Each PhysicsSystem holds its
+// library, even after swapping it out, for as long as its bodies may use it.
+class CollisionShapeLibrary {
+public:
+    CollisionShapeLibrary() = default;
+    CollisionShapeLibrary(const CollisionShapeLibrary&) = delete;
+    CollisionShapeLibrary& operator=(const CollisionShapeLibrary&) = delete;
+    
+    btCollisionShape* Acquire(const Collider& collider);
+    
+    size_t GetShapeCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return shapes.size();
+    }
+
+private:
+    // The dimensions the collider's type actually uses, unused ones zeroed
+    struct ShapeKey {
+        ColliderType type;
+        float dimensions[3];
+        
+        bool operator==(const ShapeKey& other) const {
+            return type == other.type && std::memcmp(dimensions, other.dimensions, sizeof(dimensions)) == 0;
+        }
+    };
+    
+    struct ShapeKeyHash {
+        size_t operator()(const ShapeKey& key) const {
+            uint32_t bits[3];
+            std::memcpy(bits, key.dimensions, sizeof(bits));
+            size_t hash = static_cast<size_t>(key.type);
+            for (uint32_t b : bits) {
+                hash = hash * 1000003u ^ b;
+            }
+            return hash;
+        }
+    };
+    
+    static ShapeKey MakeKey(const Collider& collider);
+    
+    mutable std::mutex mutex;
+    std::unordered_map<ShapeKey, std::unique_ptr<btCollisionShape>, ShapeKeyHash> shapes;
+};
+
 class PhysicsSystem : public System {
 private:
     std::unique_ptr<btDefaultCollisionConfiguration> collisionConfiguration;
@@ -20,11 +112,42 @@ private:
     std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
     
     std::unordered_map<uint32_t, btRigidBody*> rigidBodies;
-    std::unordered_map<uint32_t, btCollisionShape*> collisionShapes;
+    std::unordered_map<uint32_t, btCollisionShape*> collisionShapes;   // Owned ones only, not the library's
+    std::shared_ptr<CollisionShapeLibrary> shapeLibrary;
+    std::vector<std::shared_ptr<CollisionShapeLibrary>> retiredShapeLibraries;   // Swapped out while bodies existed
+    
+    struct TrackedBody {
+        std::shared_ptr<Entity> entity;
+        btRigidBody* body;
+    };
+    // Kinematic bodies follow their Transform automatically before each step;
+    // only Transforms changed since the last run are pushed.
+    std::vector<TrackedBody> kinematicBodies;
+    // Dynamic bodies write their pose back after each step while awake
+    std::vector<TrackedBody> dynamicBodies;
     
     bool gravityEnabled;
     glm::vec3 gravity;
     
+    struct ActiveContact {
+        uint64_t key;
+        glm::vec3 point;
+        glm::vec3 normal;
+        float impulse;
+    };
+    
+    JobPool* jobPool;
+    
+    ContactEventBuffer contactEvents;
+    std::vector<ActiveContact> currentContacts;
+    std::vector<ActiveContact> previousContacts;
+    bool reportAllContacts;
+    
+    uint64_t frameCount;
+    
+    void ResetWorld();
+    void RecreateDynamicsWorld();
+    
 public:
     PhysicsSystem();
     ~PhysicsSystem();
@@ -33,9 +156,20 @@ public:
     void Cleanup();
     
     void Update(float deltaTime) override;
+    // Registers the observers that create, rebuild and release bodies as
+    // physics components are added, replaced and removed
+    void OnAddedToWorld() override;
     
     void CreateRigidBody(std::shared_ptr<Entity> entity);
+    // Creates bodies for every entity in the list that has the physics
+    // components but no body yet, then rebalances the broadphase once
+    void CreateRigidBodies(const EntityList& entities);
     void DestroyRigidBody(std::shared_ptr<Entity> entity);
+    // Bodies of destroyed entities are released here, so callers no longer
+    // need to call DestroyRigidBody before World::DestroyEntity
+    void OnEntitiesDestroyed(const EntityList& entities) override;
+    // Kinematic bodies are streamed from their Transform before every step;
+    // this only forces an immediate sync outside of Update.
     void UpdateRigidBody(std::shared_ptr<Entity> entity);
     
     void SetGravity(const glm::vec3& g);
@@ -50,12 +184,59 @@ public:
     
     void SyncTransformToBullet(std::shared_ptr<Entity> entity);
     
+    // Contact events produced by the last Update. Only pairs where at least one
+    // body has RigidBody::reportContacts set are reported, unless
+    // SetReportAllContacts(true) is used.
+    const ContactEventBuffer& GetContactEvents() const { return contactEvents; }
+    void SetReportAllContacts(bool enable) { reportAllContacts = enable; }
+    bool IsReportingAllContacts() const { return reportAllContacts; }
+    
+    // Batched scene queries. Queries are split across the job pool and run
+    // against the broadphase concurrently; hits are reported by entity id.
+    // Must not be called while the simulation is stepping.
+    void RaycastBatch(const RaycastQuery* rays, size_t count, QueryHit* hits);
+    void SweepBatch(const SweepQuery* sweeps, size_t count, QueryHit* hits);
+    // Broadphase-level test: reports bodies whose AABB overlaps the shape's AABB
+    void OverlapBatch(const OverlapQuery* queries, size_t count, OverlapResults& results);
+    
+    void RaycastBatch(const std::vector<RaycastQuery>& rays, std::vector<QueryHit>& hits) {
+        hits.resize(rays.size());
+        RaycastBatch(rays.data(), rays.size(), hits.data());
+    }
+    void SweepBatch(const std::vector<SweepQuery>& sweeps, std::vector<QueryHit>& hits) {
+        hits.resize(sweeps.size());
+        SweepBatch(sweeps.data(), sweeps.size(), hits.data());
+    }
+    void OverlapBatch(const std::vector<OverlapQuery>& queries, OverlapResults& results) {
+        OverlapBatch(queries.data(), queries.size(), results);
+    }
+    
+    void SetJobPool(JobPool* pool) { jobPool = pool ? pool : &JobPool::Default(); }
+    
+    // Bodies created from now on take their shapes from the library instead
+    // of owning one each; null goes back to owned shapes. Existing bodies keep
+    // the old library's shapes, so it is retained until they are all released.
+    void SetShapeLibrary(std::shared_ptr<CollisionShapeLibrary> library) {
+        if (shapeLibrary && shapeLibrary != library && !rigidBodies.empty()) {
+            retiredShapeLibraries.push_back(std::move(shapeLibrary));
+        }
+        shapeLibrary = std::move(library);
+    }
+    const std::shared_ptr<CollisionShapeLibrary>& GetShapeLibrary() const { return shapeLibrary; }
+    
+    // A new shape for the collider, owned by the caller
+    static btCollisionShape* CreateCollisionShape(const Collider& collider);
+    
     btDiscreteDynamicsWorld* GetDynamicsWorld() { return dynamicsWorld.get(); }
     
 private:
-    btCollisionShape* CreateCollisionShape(const Collider& collider);
     btRigidBody* CreateBulletRigidBody(const Transform& transform, const RigidBody& rb, const Collider& collider);
-    void SyncTransformFromBullet(std::shared_ptr<Entity> entity);
+    bool AddBody(std::shared_ptr<Entity> entity, const Transform& transform, RigidBody& rb, const Collider& collider);
+    void StreamKinematicBodies();
+    void ReleaseBodies(const EntityList& entities);
+    bool SyncTransformFromBullet(const std::shared_ptr<Entity>& entity, btRigidBody* body);
+    void EraseReleasedBodies(std::vector<TrackedBody>& bodies);
+    void GatherContactEvents();
     
     static glm::vec3 BulletToGLM(const btVector3& v);
     static btVector3 GLMToBullet(const glm::vec3& v);
@@ -1,9 +1,8 @@
 #ifndef ECS_PLAYER_CONTROLLER_SYSTEM_H
 #define ECS_PLAYER_CONTROLLER_SYSTEM_H
 
-#include <GLFW/glfw3.h>
-#include <iostream>
 #include "../System.h"
+#include "../Log.h"
 #include "../Components/Transform.h"
 #include "../Components/Velocity.h"
 #include "../Components/Input.h"
@@ -24,7 +23,7 @@ public:
     // Jump state tracking
     bool canJump = true;
     float jumpCooldown = 0.5f;
-    float jumpTimer = 0.0f;
+    double jumpReadyAt = 0.0;  // Time::elapsed at which the cooldown ends
     
     // Mouse look state
     bool wasRightMousePressed = false;
@@ -32,19 +31,14 @@ public:
     PlayerControllerSystem() {
         RequireComponents<Transform, Input, Tag>();
         SetPriority(-50); // Run after input but before movement
+        DependsOn(physics);
+        ReadsResources<Time>();
     }
     
     void Update(float deltaTime) override {
-        std::bitset<MAX_COMPONENTS> mask;
-        mask.set(Component::GetTypeId<Transform>());
-        mask.set(Component::GetTypeId<Input>());
-        mask.set(Component::GetTypeId<Tag>());
-        auto entities = world->GetEntitiesWithComponents(mask);
+        const Time* time = world->ReadResource<Time>();
         
-        for (auto& entity : entities) {
-            auto* tag = world->GetComponent<Tag>(entity);
-            if (!tag || tag->name != "Player") continue;
-            
+        for (auto& entity : world->GetEntitiesWithTag(Tags::Player)) {
             auto* transform = world->GetComponent<Transform>(entity);
             auto* input = world->GetComponent<Input>(entity);
             auto* velocity = world->GetComponent<Velocity>(entity);
@@ -63,69 +57,62 @@ public:
                 // Physics-based movement
                 glm::vec3 movement(0.0f);
                 
-                if (input->IsKeyHeld(GLFW_KEY_W)) {
+                if (input->IsKeyHeld(Key::W)) {
                     movement += transform->GetForward();
                 }
-                if (input->IsKeyHeld(GLFW_KEY_S)) {
+                if (input->IsKeyHeld(Key::S)) {
                     movement -= transform->GetForward();
                 }
-                if (input->IsKeyHeld(GLFW_KEY_A)) {
+                if (input->IsKeyHeld(Key::A)) {
                     movement -= transform->GetRight();
                 }
-                if (input->IsKeyHeld(GLFW_KEY_D)) {
+                if (input->IsKeyHeld(Key::D)) {
                     movement += transform->GetRight();
                 }
                 
                 // Apply movement force
                 if (glm::length(movement) > 0.0f) {
                     movement = glm::normalize(movement) * moveForce;
-                    auto* physicsSystem = world->GetSystem<PhysicsSystem>();
-                    if (physicsSystem) {
-                        physicsSystem->ApplyForce(entity, movement);
+                    if (physics) {
+                        physics->ApplyForce(entity, movement);
                     }
                 }
                 
                 // Jump - use IsKeyHeld for more reliable detection
-                // Update jump cooldown
-                if (jumpTimer > 0.0f) {
-                    jumpTimer -= deltaTime;
-                    if (jumpTimer <= 0.0f) {
-                        canJump = true;
-                    }
+                if (!canJump && time && time->elapsed >= jumpReadyAt) {
+                    canJump = true;
                 }
                 
-                if (input->IsKeyHeld(GLFW_KEY_SPACE) && canJump) {
-                    std::cout << "JUMP! Applying impulse of " << jumpForce << std::endl;
-                    auto* physicsSystem = world->GetSystem<PhysicsSystem>();
-                    if (physicsSystem) {
+                if (input->IsKeyHeld(Key::Space) && canJump) {
+                    ECS_LOG_DEBUG("JUMP! Applying impulse of {}", jumpForce);
+                    if (physics) {
                         // Apply large upward impulse
-                        physicsSystem->ApplyImpulse(entity, glm::vec3(0, jumpForce, 0), glm::vec3(0,0,0));
+                        physics->ApplyImpulse(entity, glm::vec3(0, jumpForce, 0), glm::vec3(0,0,0));
                         canJump = false;
-                        jumpTimer = jumpCooldown;
+                        jumpReadyAt = (time ? time->elapsed : 0.0) + jumpCooldown;
                     }
                 }
                 
                 // Downward force
-                if (input->IsKeyHeld(GLFW_KEY_LEFT_SHIFT)) {
-                    auto* physicsSystem = world->GetSystem<PhysicsSystem>();
-                    if (physicsSystem) {
-                        physicsSystem->ApplyForce(entity, glm::vec3(0, -moveForce * 2, 0));
+                if (input->IsKeyHeld(Key::LeftShift)) {
+                    if (physics) {
+                        physics->ApplyForce(entity, glm::vec3(0, -moveForce * 2, 0));
                     }
                 }
             } else {
                 // Non-physics movement (original code)
                 glm::vec3 movement(0.0f);
                 
-                if (input->IsKeyHeld(GLFW_KEY_W)) {
+                if (input->IsKeyHeld(Key::W)) {
                     movement += transform->GetForward();
                 }
-                if (input->IsKeyHeld(GLFW_KEY_S)) {
+                if (input->IsKeyHeld(Key::S)) {
                     movement -= transform->GetForward();
                 }
-                if (input->IsKeyHeld(GLFW_KEY_A)) {
+                if (input->IsKeyHeld(Key::A)) {
                     movement -= transform->GetRight();
                 }
-                if (input->IsKeyHeld(GLFW_KEY_D)) {
+                if (input->IsKeyHeld(Key::D)) {
                     movement += transform->GetRight();
                 }
                 
@@ -140,10 +127,10 @@ public:
                 }
                 
                 // Vertical movement
-                if (input->IsKeyPressed(GLFW_KEY_SPACE)) {
+                if (input->IsKeyPressed(Key::Space)) {
                     velocity->linear.y = jumpSpeed;
                 }
-                if (input->IsKeyHeld(GLFW_KEY_LEFT_SHIFT)) {
+                if (input->IsKeyHeld(Key::LeftShift)) {
                     velocity->linear.y = -moveSpeed;
                 }
                 
@@ -160,22 +147,20 @@ public:
             if (rb && rb->bulletBody) {
                 // Physics-based rotation
                 float torqueStrength = 100.0f;
-                if (input->IsKeyHeld(GLFW_KEY_LEFT) || input->IsKeyHeld(GLFW_KEY_Q)) {
-                    auto* physicsSystem = world->GetSystem<PhysicsSystem>();
-                    if (physicsSystem) {
-                        physicsSystem->ApplyTorque(entity, glm::vec3(0, torqueStrength, 0));
+                if (input->IsKeyHeld(Key::Left) || input->IsKeyHeld(Key::Q)) {
+                    if (physics) {
+                        physics->ApplyTorque(entity, glm::vec3(0, torqueStrength, 0));
                     }
-                } else if (input->IsKeyHeld(GLFW_KEY_RIGHT) || input->IsKeyHeld(GLFW_KEY_E)) {
-                    auto* physicsSystem = world->GetSystem<PhysicsSystem>();
-                    if (physicsSystem) {
-                        physicsSystem->ApplyTorque(entity, glm::vec3(0, -torqueStrength, 0));
+                } else if (input->IsKeyHeld(Key::Right) || input->IsKeyHeld(Key::E)) {
+                    if (physics) {
+                        physics->ApplyTorque(entity, glm::vec3(0, -torqueStrength, 0));
                     }
                 }
             } else {
                 // Non-physics rotation
-                if (input->IsKeyHeld(GLFW_KEY_LEFT) || input->IsKeyHeld(GLFW_KEY_Q)) {
+                if (input->IsKeyHeld(Key::Left) || input->IsKeyHeld(Key::Q)) {
                     velocity->angular.y = rotateSpeed;
-                } else if (input->IsKeyHeld(GLFW_KEY_RIGHT) || input->IsKeyHeld(GLFW_KEY_E)) {
+                } else if (input->IsKeyHeld(Key::Right) || input->IsKeyHeld(Key::E)) {
                     velocity->angular.y = -rotateSpeed;
                 } else {
                     velocity->angular.y *= 0.9f; // Angular friction
@@ -185,33 +170,35 @@ public:
             // Mouse look - track button state changes
             if (input->mouseButtons[1]) { // Right mouse button held
                 if (!wasRightMousePressed) {
-                    std::cout << "Right mouse pressed - mouse look enabled" << std::endl;
+                    ECS_LOG_DEBUG("Right mouse pressed - mouse look enabled");
                     wasRightMousePressed = true;
                 }
                 
                 float sensitivity = 0.005f;
                 // Only rotate if mouse is actually moving
                 if (glm::length(input->mouseDelta) > 0.01f) {
-                    std::cout << "Mouse delta: " << input->mouseDelta.x << ", " << input->mouseDelta.y << std::endl;
+                    ECS_LOG_TRACE("Mouse delta: {}, {}", input->mouseDelta.x, input->mouseDelta.y);
                     glm::quat yaw = glm::angleAxis(-input->mouseDelta.x * sensitivity, glm::vec3(0, 1, 0));
                     transform->rotation = yaw * transform->rotation;
                     
                     // Sync rotation to physics body if it exists
                     if (rb && rb->bulletBody) {
-                        auto* physicsSystem = world->GetSystem<PhysicsSystem>();
-                        if (physicsSystem) {
-                            physicsSystem->SyncTransformToBullet(entity);
+                        if (physics) {
+                            physics->SyncTransformToBullet(entity);
                         }
                     }
                 }
             } else {
                 if (wasRightMousePressed) {
-                    std::cout << "Right mouse released - mouse look disabled" << std::endl;
+                    ECS_LOG_DEBUG("Right mouse released - mouse look disabled");
                     wasRightMousePressed = false;
                 }
             }
         }
     }
+
+private:
+    PhysicsSystem* physics = nullptr;
 };
 
 }
@@ -1,11 +1,14 @@
 #ifndef ECS_RENDER_SYSTEM_H
 #define ECS_RENDER_SYSTEM_H
 
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
 #include "../System.h"
+#include "../World.h"
 #include "../Components/Transform.h"
 #include "../Components/Renderable.h"
+#include "../Components/Hierarchy.h"
 #include "../../CubeRenderer.h"
 #include "../../Shader.h"
 
@@ -25,26 +28,54 @@ public:
         std::bitset<MAX_COMPONENTS> mask;
         mask.set(Component::GetTypeId<Transform>());
         mask.set(Component::GetTypeId<Renderable>());
-        auto entities = world->GetEntitiesWithComponents(mask);
         
-        std::vector<glm::mat4> modelMatrices;
-        std::vector<glm::vec3> colors;
+        // Renderable edits or a different entity set change which cubes are
+        // drawn; otherwise only matrices of moved entities need rebuilding.
+        bool rebuild = GetLastRunTick() == 0 ||
+            !world->GetEntitiesWithComponents<Changed<Renderable>>(mask, GetLastRunTick()).empty();
         
-        for (auto& entity : entities) {
-            auto* transform = world->GetComponent<Transform>(entity);
-            auto* renderable = world->GetComponent<Renderable>(entity);
-            
-            if (!transform || !renderable || !renderable->visible) continue;
+        if (!rebuild) {
+            // Children of a moved parent only show up through their WorldTransform
+            auto moved = world->GetEntitiesWithComponents<Changed<Transform>>(mask, GetLastRunTick());
+            auto movedInHierarchy = world->GetEntitiesWithComponents<Changed<WorldTransform>>(mask, GetLastRunTick());
+            moved.insert(moved.end(), movedInHierarchy.begin(), movedInHierarchy.end());
             
-            if (renderable->meshType == MeshType::Cube) {
-                modelMatrices.push_back(transform->GetMatrix());
-                colors.push_back(renderable->color);
+            for (auto& entity : moved) {
+                uint32_t id = entity->GetId();
+                uint32_t slot = id < slotOfEntity.size() ? slotOfEntity[id] : NO_SLOT;
+                if (slot == NO_SLOT) {
+                    const auto* renderable = world->ReadComponent<Renderable>(entity);
+                    if (renderable->visible && renderable->meshType == MeshType::Cube) {
+                        rebuild = true;
+                        break;
+                    }
+                    continue;
+                }
+                cachedMatrices[slot] = GetModelMatrix(entity, *world->ReadComponent<Transform>(entity));
             }
         }
         
-        // Store for actual rendering in render phase
-        cachedMatrices = modelMatrices;
-        cachedColors = colors;
+        // Destroyed entities or removed components leave stale slots behind
+        rebuild |= slotsStale;
+        
+        if (rebuild) {
+            RebuildCache(world->GetEntitiesWithComponents(mask));
+            slotsStale = false;
+        }
+    }
+    
+    void OnAddedToWorld() override {
+        auto markStale = [this](const EntityList& entities) {
+            for (auto& entity : entities) {
+                uint32_t id = entity->GetId();
+                if (id < slotOfEntity.size() && slotOfEntity[id] != NO_SLOT) {
+                    slotsStale = true;
+                    return;
+                }
+            }
+        };
+        world->OnRemove<Transform>(markStale);
+        world->OnRemove<Renderable>(markStale);
     }
     
     void Render() {
@@ -64,12 +95,53 @@ public:
     const std::vector<glm::mat4>& GetCachedMatrices() const { 
         return cachedMatrices; 
     }
-    
+
 private:
+    // Entities in a transform hierarchy render at their composed world matrix
+    glm::mat4 GetModelMatrix(const std::shared_ptr<Entity>& entity, const Transform& transform) const {
+        if (const auto* worldTransform = world->ReadComponent<WorldTransform>(entity)) {
+            return worldTransform->matrix;
+        }
+        return transform.GetMatrix();
+    }
+    
+    // Reuses every array's capacity, so a rebuild of a same-sized scene does not allocate
+    void RebuildCache(const EntityList& entities) {
+        for (auto& entity : slotEntities) {
+            slotOfEntity[entity->GetId()] = NO_SLOT;
+        }
+        cachedMatrices.clear();
+        cachedColors.clear();
+        slotEntities.clear();
+        
+        for (auto& entity : entities) {
+            const auto* transform = world->ReadComponent<Transform>(entity);
+            const auto* renderable = world->ReadComponent<Renderable>(entity);
+            
+            if (!transform || !renderable || !renderable->visible) continue;
+            
+            if (renderable->meshType == MeshType::Cube) {
+                uint32_t id = entity->GetId();
+                if (id >= slotOfEntity.size()) {
+                    slotOfEntity.resize(id + 1, NO_SLOT);
+                }
+                slotOfEntity[id] = static_cast<uint32_t>(cachedMatrices.size());
+                slotEntities.push_back(entity);
+                cachedMatrices.push_back(GetModelMatrix(entity, *transform));
+                cachedColors.push_back(renderable->color);
+            }
+        }
+    }
+    
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    
     CubeRenderer* cubeRenderer;
     Shader* shader;
     std::vector<glm::mat4> cachedMatrices;
     std::vector<glm::vec3> cachedColors;
+    std::vector<std::shared_ptr<Entity>> slotEntities;  // Entity per cached slot
+    std::vector<uint32_t> slotOfEntity;                 // Entity id -> cached slot
+    bool slotsStale = false;                            // A cached entity lost a component
 };
 
 }
@@ -0,0 +1,124 @@
+#ifndef ECS_SCRIPTED_INPUT_SYSTEM_H
+#define ECS_SCRIPTED_INPUT_SYSTEM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../System.h"
+#include "../World.h"
+#include "../Components/Input.h"
+
+namespace ECS {
+
+struct ScriptedKeyEvent {
+    uint64_t tick;
+    int key;
+    bool pressed;
+};
+
+// Drives Input components from a list of timed key events instead of a
+// window, so the simulation can run headless. Takes InputSystem's place
+// in the update order.
+class ScriptedInputSystem : public System {
+public:
+    ScriptedInputSystem() {
+        RequireComponents<Input>();
+        SetPriority(-100); // Run first, like InputSystem
+    }
+    
+    void AddEvent(uint64_t tick, int key, bool pressed) {
+        events.push_back({tick, key, pressed});
+        sorted = false;
+    }
+    
+    // One event per line: "<tick> <key> <down|up>", where key is a key code
+    // or a name such as W, Space or LeftShift. '#' starts a comment.
+    bool LoadScript(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) return false;
+        
+        std::string line;
+        while (std::getline(file, line)) {
+            line = line.substr(0, line.find('#'));
+            std::istringstream stream(line);
+            uint64_t tick;
+            std::string keyName, action;
+            if (!(stream >> tick >> keyName >> action)) continue;
+            
+            int key = ParseKey(keyName);
+            if (key < 0 || (action != "down" && action != "up")) return false;
+            AddEvent(tick, key, action == "down");
+        }
+        return true;
+    }
+    
+    uint64_t GetTick() const { return tick; }
+    size_t GetEventCount() const { return events.size(); }
+    bool IsFinished() const { return nextEvent >= events.size(); }
+    
+    void Update(float deltaTime) override {
+        if (!sorted) {
+            std::stable_sort(events.begin(), events.end(),
+                [](const ScriptedKeyEvent& a, const ScriptedKeyEvent& b) { return a.tick < b.tick; });
+            sorted = true;
+        }
+        
+        while (nextEvent < events.size() && events[nextEvent].tick <= tick) {
+            keyDown[events[nextEvent].key] = events[nextEvent].pressed;
+            nextEvent++;
+        }
+        
+        std::bitset<MAX_COMPONENTS> mask;
+        mask.set(Component::GetTypeId<Input>());
+        auto entities = world->GetEntitiesWithComponents(mask);
+        
+        for (auto& entity : entities) {
+            auto* input = world->GetComponent<Input>(entity);
+            if (!input) continue;
+            
+            input->BeginFrame();
+            for (const auto& [key, pressed] : keyDown) {
+                input->UpdateKey(key, pressed);
+            }
+        }
+    }
+    
+    void PostUpdate(float deltaTime) override {
+        tick++;
+    }
+
+private:
+    static int ParseKey(const std::string& name) {
+        static const std::pair<const char*, int> names[] = {
+            {"Space", Key::Space}, {"W", Key::W}, {"A", Key::A}, {"S", Key::S}, {"D", Key::D},
+            {"Q", Key::Q}, {"E", Key::E}, {"R", Key::R}, {"F", Key::F},
+            {"1", Key::Num1}, {"2", Key::Num2}, {"3", Key::Num3},
+            {"4", Key::Num4}, {"5", Key::Num5}, {"6", Key::Num6},
+            {"Escape", Key::Escape}, {"Enter", Key::Enter}, {"Tab", Key::Tab},
+            {"Up", Key::Up}, {"Down", Key::Down}, {"Left", Key::Left}, {"Right", Key::Right},
+            {"LeftShift", Key::LeftShift}, {"LeftControl", Key::LeftControl}
+        };
+        for (const auto& [keyName, code] : names) {
+            if (name == keyName) return code;
+        }
+        
+        char* end = nullptr;
+        long code = std::strtol(name.c_str(), &end, 10);
+        return (end && *end == '\0' && code > 0) ? static_cast<int>(code) : -1;
+    }
+    
+    std::vector<ScriptedKeyEvent> events;
+    std::unordered_map<int, bool> keyDown;
+    size_t nextEvent = 0;
+    uint64_t tick = 0;
+    bool sorted = true;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,379 @@
+#ifndef ECS_SPATIAL_INDEX_SYSTEM_H
+#define ECS_SPATIAL_INDEX_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../System.h"
+#include "../World.h"
+#include "../JobPool.h"
+#include "../Components/Transform.h"
+#include "../Components/Hierarchy.h"
+
+namespace ECS {
+
+// Uniform hash grid over the positions of every entity with a Transform
+// (WorldTransform when it has one). Cells hash into a table of buckets laid
+// out contiguously; a full rebuild is a parallel counting sort. When only a
+// few entities move, they are patched into small overflow buckets instead,
+// until enough have moved that rebuilding is cheaper.
+class SpatialIndexSystem : public System {
+public:
+    explicit SpatialIndexSystem(float cellSize = 4.0f)
+        : cellSize(cellSize), inverseCellSize(1.0f / cellSize), jobPool(&JobPool::Default()) {
+        RequireComponents<Transform>();
+        SetPriority(95); // After the transform hierarchy, before render
+    }
+    
+    void SetJobPool(JobPool* pool) { jobPool = pool ? pool : &JobPool::Default(); }
+    
+    float GetCellSize() const { return cellSize; }
+    size_t GetEntityCount() const { return records.size(); }
+    
+    void Update(float deltaTime) override {
+        std::bitset<MAX_COMPONENTS> mask;
+        mask.set(Component::GetTypeId<Transform>());
+        
+        uint32_t sinceTick = GetLastRunTick();
+        bool rebuild = sinceTick == 0;
+        
+        EntityList moved(world->GetFrameAllocator<std::shared_ptr<Entity>>());
+        if (!rebuild) {
+            moved = world->GetEntitiesWithComponents<Changed<Transform>>(mask, sinceTick);
+            auto movedInHierarchy = world->GetEntitiesWithComponents<Changed<WorldTransform>>(mask, sinceTick);
+            moved.insert(moved.end(), movedInHierarchy.begin(), movedInHierarchy.end());
+            rebuild = (moved.size() + overflowCount) * REBUILD_DIVISOR > records.size();
+        }
+        
+        // Removed entities would leave holes in the bucket layout
+        rebuild |= recordsStale;
+        
+        if (rebuild) {
+            Rebuild(world->GetEntitiesWithComponents(mask));
+            recordsStale = false;
+        } else {
+            for (auto& entity : moved) {
+                Move(entity);
+            }
+        }
+    }
+    
+    void OnAddedToWorld() override {
+        world->OnRemove<Transform>([this](const EntityList& entities) {
+            for (auto& entity : entities) {
+                uint32_t id = entity->GetId();
+                if (id < recordOf.size() && recordOf[id] != NONE) {
+                    recordsStale = true;
+                    return;
+                }
+            }
+        });
+    }
+    
+    // Entities within radius of center
+    EntityList QueryRadius(const glm::vec3& center, float radius) {
+        EntityList result(world->GetFrameAllocator<std::shared_ptr<Entity>>());
+        float radiusSq = radius * radius;
+        ForEachInBox(center - glm::vec3(radius), center + glm::vec3(radius), [&](const Record& record) {
+            if (DistanceSq(record.position, center) <= radiusSq) {
+                result.push_back(record.entity);
+            }
+        });
+        return result;
+    }
+    
+    // Entities whose position lies inside the box, bounds included
+    EntityList QueryAABB(const glm::vec3& min, const glm::vec3& max) {
+        EntityList result(world->GetFrameAllocator<std::shared_ptr<Entity>>());
+        ForEachInBox(min, max, [&](const Record& record) {
+            result.push_back(record.entity);
+        });
+        return result;
+    }
+    
+    // Up to k entities closest to point, nearest first (ties by entity id)
+    EntityList QueryNearest(const glm::vec3& point, size_t k,
+                            float maxRadius = std::numeric_limits<float>::infinity()) {
+        EntityList result(world->GetFrameAllocator<std::shared_ptr<Entity>>());
+        if (k == 0 || records.empty()) return result;
+        
+        FrameVector<std::pair<float, uint32_t>> candidates(world->GetFrameAllocator<std::pair<float, uint32_t>>());
+        
+        // Grow the search sphere until it holds k entities or covers every entity
+        float coverRadius = std::sqrt(std::max(DistanceSq(point, boundsMin), DistanceSq(point, boundsMax)));
+        float radius = cellSize;
+        for (;;) {
+            radius = std::min(radius, maxRadius);
+            float radiusSq = radius * radius;
+            candidates.clear();
+            ForEachInBox(point - glm::vec3(radius), point + glm::vec3(radius), [&](const Record& record) {
+                float distanceSq = DistanceSq(record.position, point);
+                if (distanceSq <= radiusSq) {
+                    candidates.push_back({distanceSq, static_cast<uint32_t>(&record - records.data())});
+                }
+            });
+            if (candidates.size() >= k || radius >= maxRadius || radius >= coverRadius) break;
+            radius *= 2.0f;
+        }
+        
+        size_t count = std::min(k, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+            [this](const auto& a, const auto& b) {
+                if (a.first != b.first) return a.first < b.first;
+                return records[a.second].entity->GetId() < records[b.second].entity->GetId();
+            });
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(records[candidates[i].second].entity);
+        }
+        return result;
+    }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr size_t REBUILD_DIVISOR = 4;   // Rebuild once a quarter of the entities moved
+    static constexpr size_t ENTITIES_PER_JOB = 4096;
+    static constexpr size_t MIN_BUCKETS = 1024;
+    
+    struct Record {
+        std::shared_ptr<Entity> entity;
+        glm::vec3 position;
+        uint32_t bucket;
+        uint32_t overflowSlot;  // Index in overflowBuckets[bucket], NONE while in the base layout
+    };
+    
+    struct Cell {
+        int32_t x, y, z;
+        bool operator==(const Cell& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+    
+    static float DistanceSq(const glm::vec3& a, const glm::vec3& b) {
+        glm::vec3 d = a - b;
+        return d.x * d.x + d.y * d.y + d.z * d.z;
+    }
+    
+    int32_t CellCoord(float value) const {
+        return static_cast<int32_t>(std::floor(value * inverseCellSize));
+    }
+    
+    Cell CellOf(const glm::vec3& position) const {
+        return {CellCoord(position.x), CellCoord(position.y), CellCoord(position.z)};
+    }
+    
+    uint32_t BucketOf(const Cell& cell) const {
+        uint32_t hash = static_cast<uint32_t>(cell.x) * 73856093u ^
+                        static_cast<uint32_t>(cell.y) * 19349663u ^
+                        static_cast<uint32_t>(cell.z) * 83492791u;
+        return hash & bucketMask;
+    }
+    
+    glm::vec3 PositionOf(const std::shared_ptr<Entity>& entity) const {
+        if (const auto* worldTransform = world->ReadComponent<WorldTransform>(entity)) {
+            return worldTransform->GetPosition();
+        }
+        return world->ReadComponent<Transform>(entity)->position;
+    }
+    
+    void GrowBounds(const glm::vec3& position) {
+        boundsMin = glm::vec3(std::min(boundsMin.x, position.x), std::min(boundsMin.y, position.y),
+                              std::min(boundsMin.z, position.z));
+        boundsMax = glm::vec3(std::max(boundsMax.x, position.x), std::max(boundsMax.y, position.y),
+                              std::max(boundsMax.z, position.z));
+    }
+    
+    // Visits every record whose cell overlaps the box. Buckets are shared by
+    // several cells, so a record is only reported from its own cell.
+    template<typename Func>
+    void ForEachInBox(const glm::vec3& min, const glm::vec3& max, Func&& func) const {
+        if (records.empty()) return;
+        
+        Cell low = CellOf(min);
+        Cell high = CellOf(max);
+        auto inBox = [&](const glm::vec3& p) {
+            return p.x >= min.x && p.y >= min.y && p.z >= min.z &&
+                   p.x <= max.x && p.y <= max.y && p.z <= max.z;
+        };
+        
+        // A box spanning more cells than there are buckets is cheaper to scan
+        double cellCount = (double(high.x) - low.x + 1) * (double(high.y) - low.y + 1) * (double(high.z) - low.z + 1);
+        if (cellCount > static_cast<double>(bucketMask) + 1.0) {
+            for (const auto& record : records) {
+                if (inBox(record.position)) func(record);
+            }
+            return;
+        }
+        
+        for (int32_t x = low.x; x <= high.x; ++x) {
+            for (int32_t y = low.y; y <= high.y; ++y) {
+                for (int32_t z = low.z; z <= high.z; ++z) {
+                    Cell cell = {x, y, z};
+                    uint32_t bucket = BucketOf(cell);
+                    auto visit = [&](uint32_t index) {
+                        const Record& record = records[index];
+                        if (CellOf(record.position) == cell && inBox(record.position)) func(record);
+                    };
+                    
+                    for (uint32_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                        if (records[bucketEntries[i]].overflowSlot == NONE) visit(bucketEntries[i]);
+                    }
+                    if (overflowCount > 0) {
+                        auto it = overflowBuckets.find(bucket);
+                        if (it != overflowBuckets.end()) {
+                            for (uint32_t index : it->second) visit(index);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    // Parallel counting sort of every entity into the bucket table
+    void Rebuild(const EntityList& entities) {
+        size_t count = entities.size();
+        
+        for (const auto& record : records) {
+            recordOf[record.entity->GetId()] = NONE;
+        }
+        records.resize(count);
+        overflowBuckets.clear();
+        overflowCount = 0;
+        
+        uint32_t maxId = 0;
+        for (const auto& entity : entities) {
+            maxId = std::max(maxId, entity->GetId());
+        }
+        if (recordOf.size() <= maxId) {
+            recordOf.resize(maxId + 1, NONE);
+        }
+        
+        size_t bucketCount = MIN_BUCKETS;
+        while (bucketCount < count * 2) bucketCount *= 2;
+        if (bucketCount != bucketMask + 1 || !bucketCursor) {
+            bucketMask = static_cast<uint32_t>(bucketCount - 1);
+            bucketCursor = std::make_unique<std::atomic<uint32_t>[]>(bucketCount);
+            bucketStart.resize(bucketCount + 1);
+        }
+        for (size_t b = 0; b < bucketCount; ++b) {
+            bucketCursor[b].store(0, std::memory_order_relaxed);
+        }
+        bucketEntries.resize(count);
+        
+        jobPool->ParallelFor(count, ENTITIES_PER_JOB, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Record& record = records[i];
+                record.entity = entities[i];
+                record.position = PositionOf(record.entity);
+                record.bucket = BucketOf(CellOf(record.position));
+                record.overflowSlot = NONE;
+                recordOf[record.entity->GetId()] = static_cast<uint32_t>(i);
+                bucketCursor[record.bucket].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        
+        uint32_t offset = 0;
+        for (size_t b = 0; b < bucketCount; ++b) {
+            bucketStart[b] = offset;
+            offset += bucketCursor[b].load(std::memory_order_relaxed);
+            bucketCursor[b].store(bucketStart[b], std::memory_order_relaxed);
+        }
+        bucketStart[bucketCount] = offset;
+        
+        jobPool->ParallelFor(count, ENTITIES_PER_JOB, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t slot = bucketCursor[records[i].bucket].fetch_add(1, std::memory_order_relaxed);
+                bucketEntries[slot] = static_cast<uint32_t>(i);
+            }
+        });
+        
+        // Scatter order depends on thread timing; sort so query results are deterministic
+        jobPool->ParallelFor(bucketCount, ENTITIES_PER_JOB, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b) {
+                if (bucketStart[b + 1] - bucketStart[b] > 1) {
+                    std::sort(bucketEntries.begin() + bucketStart[b], bucketEntries.begin() + bucketStart[b + 1]);
+                }
+            }
+        });
+        
+        boundsMin = glm::vec3(std::numeric_limits<float>::max());
+        boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const auto& record : records) {
+            GrowBounds(record.position);
+        }
+    }
+    
+    // Incremental path: entities that leave their bucket go to overflow buckets
+    void Move(const std::shared_ptr<Entity>& entity) {
+        uint32_t id = entity->GetId();
+        if (recordOf.size() <= id) {
+            recordOf.resize(id + 1, NONE);
+        }
+        
+        glm::vec3 position = PositionOf(entity);
+        GrowBounds(position);
+        uint32_t bucket = BucketOf(CellOf(position));
+        
+        uint32_t index = recordOf[id];
+        if (index == NONE) {
+            index = static_cast<uint32_t>(records.size());
+            recordOf[id] = index;
+            records.push_back({entity, position, bucket, NONE});
+            AddToOverflow(index);
+            return;
+        }
+        
+        Record& record = records[index];
+        record.position = position;
+        if (record.bucket == bucket) return;
+        
+        if (record.overflowSlot != NONE) {
+            RemoveFromOverflow(index);
+        }
+        record.bucket = bucket;
+        AddToOverflow(index);
+    }
+    
+    void AddToOverflow(uint32_t index) {
+        auto& list = overflowBuckets[records[index].bucket];
+        records[index].overflowSlot = static_cast<uint32_t>(list.size());
+        list.push_back(index);
+        overflowCount++;
+    }
+    
+    void RemoveFromOverflow(uint32_t index) {
+        Record& record = records[index];
+        auto& list = overflowBuckets[record.bucket];
+        uint32_t moved = list.back();
+        list[record.overflowSlot] = moved;
+        records[moved].overflowSlot = record.overflowSlot;
+        list.pop_back();
+        record.overflowSlot = NONE;
+        overflowCount--;
+    }
+    
+    float cellSize;
+    float inverseCellSize;
+    JobPool* jobPool;
+    
+    std::vector<Record> records;
+    std::vector<uint32_t> recordOf;         // Entity id -> record index
+    uint32_t bucketMask = 0;
+    std::vector<uint32_t> bucketStart;      // Bucket b owns bucketEntries[bucketStart[b], bucketStart[b + 1])
+    std::vector<uint32_t> bucketEntries;    // Record indices
+    std::unique_ptr<std::atomic<uint32_t>[]> bucketCursor;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> overflowBuckets;
+    size_t overflowCount = 0;
+    bool recordsStale = false;              // An indexed entity lost its Transform
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+}
+
+#endif
\ No newline at end of file
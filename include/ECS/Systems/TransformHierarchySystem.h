@@ -0,0 +1,198 @@
+#ifndef ECS_TRANSFORM_HIERARCHY_SYSTEM_H
+#define ECS_TRANSFORM_HIERARCHY_SYSTEM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../System.h"
+#include "../World.h"
+#include "../JobPool.h"
+#include "../Components/Transform.h"
+#include "../Components/Hierarchy.h"
+
+namespace ECS {
+
+// Composes Transform (local to the parent) into WorldTransform for every
+// entity that has both. Each root's subtree is kept as a flat, depth-sorted
+// node list so parents are always visited before their children; only
+// nodes whose own Transform or an ancestor changed are recomputed, and
+// independent roots are processed in parallel.
+class TransformHierarchySystem : public System {
+public:
+    TransformHierarchySystem() : jobPool(&JobPool::Default()) {
+        RequireComponents<Transform, WorldTransform>();
+        SetPriority(90); // After everything that moves entities, before render
+    }
+    
+    void SetJobPool(JobPool* pool) { jobPool = pool ? pool : &JobPool::Default(); }
+    
+    // Attaches child under parent; returns false if that would form a cycle
+    bool SetParent(std::shared_ptr<Entity> child, std::shared_ptr<Entity> parent) {
+        if (!child || !parent || child == parent) return false;
+        
+        for (auto ancestor = parent; ancestor; ) {
+            if (ancestor == child) return false;
+            const auto* link = world->ReadComponent<Parent>(ancestor);
+            ancestor = link ? link->entity : nullptr;
+        }
+        
+        RemoveParent(child);
+        world->AddComponent<Parent>(child, Parent(parent));
+        structureDirty = true;
+        
+        auto* children = world->GetComponent<Children>(parent);
+        if (!children) {
+            children = world->AddComponent<Children>(parent, Children());
+        }
+        children->entities.push_back(child);
+        
+        if (!world->HasComponent<WorldTransform>(child)) world->AddComponent<WorldTransform>(child, WorldTransform());
+        if (!world->HasComponent<WorldTransform>(parent)) world->AddComponent<WorldTransform>(parent, WorldTransform());
+        return true;
+    }
+    
+    void RemoveParent(std::shared_ptr<Entity> child) {
+        const auto* link = world->ReadComponent<Parent>(child);
+        if (!link) return;
+        
+        if (auto* siblings = world->GetComponent<Children>(link->entity)) {
+            auto& list = siblings->entities;
+            list.erase(std::remove(list.begin(), list.end(), child), list.end());
+        }
+        world->RemoveComponent<Parent>(child);
+        structureDirty = true;
+    }
+    
+    void Update(float deltaTime) override {
+        bool rebuilt = false;
+        if (structureDirty) {
+            Rebuild(world->GetEntitiesWithComponents(HierarchyMask()), HierarchyMask());
+            structureDirty = false;
+            rebuilt = true;
+        }
+        
+        uint32_t sinceTick = GetLastRunTick();
+        jobPool->ParallelFor(trees.size(), ROOTS_PER_JOB, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t) {
+                UpdateTree(trees[t], sinceTick, rebuilt);
+            }
+        });
+    }
+
+    // Reparenting, new members and members losing a component or being
+    // destroyed invalidate the cached trees; a static hierarchy costs nothing
+    void OnAddedToWorld() override {
+        auto joined = [this](const EntityList& entities) {
+            for (auto& entity : entities) {
+                if ((entity->GetComponentMask() & HierarchyMask()) == HierarchyMask()) {
+                    structureDirty = true;
+                    return;
+                }
+            }
+        };
+        auto left = [this](const EntityList& entities) {
+            for (auto& entity : entities) {
+                uint32_t id = entity->GetId();
+                if (id < inTree.size() && inTree[id]) {
+                    structureDirty = true;
+                    return;
+                }
+            }
+        };
+        auto linked = [this](const EntityList&) { structureDirty = true; };
+        
+        world->OnAdd<Transform>(joined);
+        world->OnAdd<WorldTransform>(joined);
+        world->OnRemove<Transform>(left);
+        world->OnRemove<WorldTransform>(left);
+        world->OnAdd<Parent>(linked);
+        world->OnSet<Parent>(linked);
+        world->OnRemove<Parent>(left);
+        world->OnAdd<Children>(linked);
+        world->OnSet<Children>(linked);
+        world->OnRemove<Children>(left);
+    }
+
+private:
+    static constexpr size_t ROOTS_PER_JOB = 16;
+    
+    static const std::bitset<MAX_COMPONENTS>& HierarchyMask() {
+        static const std::bitset<MAX_COMPONENTS> mask = [] {
+            std::bitset<MAX_COMPONENTS> m;
+            m.set(Component::GetTypeId<Transform>());
+            m.set(Component::GetTypeId<WorldTransform>());
+            return m;
+        }();
+        return mask;
+    }
+    
+    struct Node {
+        std::shared_ptr<Entity> entity;
+        int parent;               // Index into the same tree, -1 for the root
+        bool dirty;
+        glm::mat4 worldMatrix;
+    };
+    
+    struct Tree {
+        std::vector<Node> nodes;  // Breadth-first, so parents precede children
+    };
+    
+    void Rebuild(const EntityList& entities, const std::bitset<MAX_COMPONENTS>& mask) {
+        trees.clear();
+        std::fill(inTree.begin(), inTree.end(), 0);
+        
+        auto inHierarchy = [&mask](const std::shared_ptr<Entity>& entity) {
+            return entity && entity->IsActive() && (entity->GetComponentMask() & mask) == mask;
+        };
+        
+        for (auto& entity : entities) {
+            const auto* link = world->ReadComponent<Parent>(entity);
+            if (link && inHierarchy(link->entity)) continue;
+            
+            Tree tree;
+            tree.nodes.push_back({entity, -1, true, glm::mat4(1.0f)});
+            
+            for (size_t i = 0; i < tree.nodes.size(); ++i) {
+                const auto* children = world->ReadComponent<Children>(tree.nodes[i].entity);
+                if (!children) continue;
+                
+                for (auto& child : children->entities) {
+                    if (!inHierarchy(child)) continue;
+                    tree.nodes.push_back({child, static_cast<int>(i), true, glm::mat4(1.0f)});
+                }
+            }
+            for (const auto& node : tree.nodes) {
+                uint32_t id = node.entity->GetId();
+                if (id >= inTree.size()) inTree.resize(id + 1, 0);
+                inTree[id] = 1;
+            }
+            trees.push_back(std::move(tree));
+        }
+    }
+    
+    void UpdateTree(Tree& tree, uint32_t sinceTick, bool force) {
+        for (auto& node : tree.nodes) {
+            bool parentDirty = node.parent >= 0 && tree.nodes[node.parent].dirty;
+            // Transforms are stored inline and move as others come and go, so
+            // they are looked up each run rather than cached in the node
+            node.dirty = force || parentDirty || world->GetComponentTicks<Transform>(node.entity).changed > sinceTick;
+            if (!node.dirty) continue;
+            
+            glm::mat4 localMatrix = world->ReadComponent<Transform>(node.entity)->GetMatrix();
+            node.worldMatrix = node.parent >= 0
+                ? tree.nodes[node.parent].worldMatrix * localMatrix
+                : localMatrix;
+            world->GetComponent<WorldTransform>(node.entity)->matrix = node.worldMatrix;
+        }
+    }
+    
+    JobPool* jobPool;
+    std::vector<Tree> trees;
+    std::vector<uint8_t> inTree;       // By entity id, for the nodes of trees
+    bool structureDirty = true;
+};
+
+}
+
+#endif
\ No newline at end of file
@@ -3,18 +3,88 @@
 
 #include <memory>
 #include <vector>
+#include <array>
 #include <unordered_map>
 #include <typeindex>
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
 #include "Entity.h"
 #include "Component.h"
+#include "ComponentStorage.h"
 #include "System.h"
+#include "Profiler.h"
+#include "FrameArena.h"
+#include "Prefab.h"
+#include "Resource.h"
+#include "Components/Tag.h"
+#include "Resources/Time.h"
 
 namespace ECS {
 
+// Query filters for GetEntitiesWithComponents(mask, sinceTick)
+template<typename T>
+struct Added {
+    static_assert(!std::is_empty_v<T>, "Filters need a stored component type");
+    using ComponentType = T;
+    static bool Matches(const ComponentTicks& ticks, uint32_t sinceTick) {
+        return ticks.added > sinceTick;
+    }
+};
+
+// Adding a component also counts as changing it
+template<typename T>
+struct Changed {
+    static_assert(!std::is_empty_v<T>, "Filters need a stored component type");
+    using ComponentType = T;
+    static bool Matches(const ComponentTicks& ticks, uint32_t sinceTick) {
+        return ticks.changed > sinceTick;
+    }
+};
+
+// Component lifecycle events reported to observers, in flush order
+enum class ComponentEvent {
+    Remove = 0,
+    Add = 1,
+    Set = 2   // AddComponent on an entity that already had the component
+};
+
+constexpr size_t COMPONENT_EVENT_COUNT = 3;
+
+// What destroying an entity does to the entities that have pairs targeting it
+enum class RelationCleanup {
+    RemovePair,     // They lose the pair and otherwise live on
+    DestroySource   // They are destroyed along with it, e.g. owned attachments
+};
+
+using ObserverId = uint32_t;
+using ObserverCallback = std::function<void(const EntityList&)>;
+
+// Dense view of every component of one plain type, for batch loops and
+// bulk serialization. Invalidated by adding or removing a component of
+// that type.
+template<typename T>
+struct ComponentArray {
+    T* data = nullptr;
+    const uint32_t* entityIds = nullptr;
+    size_t size = 0;
+};
+
 class World {
 public:
-    World() : nextEntityId(1) {}
+    World() : nextEntityId(1), changeTick(1), frameKey(FrameArena::NewFrameKey()) {
+        systemGroups.push_back(SystemGroup());  // Index 0: systems without a group
+        SetResource<Time>();
+    }
     ~World() = default;
     
     std::shared_ptr<Entity> CreateEntity() {
@@ -24,46 +94,326 @@ public:
     }
     
     void DestroyEntity(std::shared_ptr<Entity> entity) {
-        if (!entity) return;
+        DestroyEntities(&entity, &entity + 1);
+    }
+    
+    // Destroys a batch of entities in one pass over the entity list and the
+    // affected storages. Systems are told once through OnEntitiesDestroyed,
+    // before any component is removed. Null, inactive and repeated entries
+    // are skipped. Returns the number destroyed.
+    template<typename Iterator>
+    size_t DestroyEntities(Iterator first, Iterator last) {
+        if (destroyMarks.size() < nextEntityId) {
+            destroyMarks.resize(nextEntityId, 0);
+        }
+        
+        EntityList doomed(GetFrameAllocator<std::shared_ptr<Entity>>());
+        for (; first != last; ++first) {
+            const std::shared_ptr<Entity>& entity = *first;
+            if (!entity || !entity->IsActive() || destroyMarks[entity->GetId()]) continue;
+            destroyMarks[entity->GetId()] = 1;
+            doomed.push_back(entity);
+        }
+        if (doomed.empty()) return 0;
+        if (!relationTypeIds.empty()) {
+            AddDestroyedSources(doomed);
+        }
+        
+        for (auto& system : systems) {
+            system->OnEntitiesDestroyed(doomed);
+        }
         
-        entity->SetActive(false);
+        FrameVector<uint32_t> ids(GetFrameAllocator<uint32_t>());
+        ids.reserve(doomed.size());
+        std::bitset<MAX_COMPONENTS> touchedTypes;
+        for (auto& entity : doomed) {
+            QueueRemoveEvents(entity);
+            UnindexTag(entity);
+            entity->SetActive(false);
+            ids.push_back(entity->GetId());
+            touchedTypes |= entity->GetComponentMask();
+        }
         
-        for (auto& [typeId, componentMap] : components) {
-            componentMap.erase(entity->GetId());
+        for (uint32_t typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+            if (touchedTypes.test(typeId) && storages[typeId]) {
+                storages[typeId]->RemoveMany(ids.data(), ids.size());
+            }
+        }
+        if (!relationTypeIds.empty()) {
+            UnlinkDestroyed(doomed);
         }
         
         entities.erase(
-            std::remove(entities.begin(), entities.end(), entity),
+            std::remove_if(entities.begin(), entities.end(),
+                [this](const std::shared_ptr<Entity>& e) { return destroyMarks[e->GetId()] != 0; }),
             entities.end()
         );
+        for (uint32_t id : ids) {
+            destroyMarks[id] = 0;
+        }
+        return doomed.size();
+    }
+    
+    template<typename Range>
+    size_t DestroyEntities(const Range& range) {
+        return DestroyEntities(std::begin(range), std::end(range));
+    }
+    
+    // Destroys every entity that has all of the given components or marker tags
+    template<typename... Components>
+    size_t DestroyAll() {
+        std::bitset<MAX_COMPONENTS> mask;
+        (mask.set(Component::GetTypeId<Components>()), ...);
+        return DestroyEntities(GetEntitiesWithComponents(mask));
+    }
+    
+    size_t DestroyEntitiesWithTag(TagId id) {
+        auto it = taggedEntities.find(id);
+        if (it == taggedEntities.end()) return 0;
+        
+        // The bucket shrinks as its entities are destroyed
+        EntityList tagged(it->second.begin(), it->second.end(), GetFrameAllocator<std::shared_ptr<Entity>>());
+        return DestroyEntities(tagged);
+    }
+    
+    // Level unload: every entity goes, storages are emptied wholesale and
+    // keep their capacity. Systems stay registered.
+    void DestroyAllEntities() {
+        EntityList all(std::make_move_iterator(entities.begin()), std::make_move_iterator(entities.end()),
+                       GetFrameAllocator<std::shared_ptr<Entity>>());
+        entities.clear();
+        if (all.empty()) return;
+        
+        for (auto& system : systems) {
+            system->OnEntitiesDestroyed(all);
+        }
+        for (auto& entity : all) {
+            QueueRemoveEvents(entity);
+            entity->SetActive(false);
+        }
+        for (auto& storage : storages) {
+            if (storage) storage->Clear();
+        }
+        addedComponents.clear();
+        taggedEntities.clear();
+        for (uint32_t typeId : relationTypeIds) {
+            relations[typeId]->targets.clear();
+            relations[typeId]->sources.clear();
+        }
+    }
+    
+    // Pre-size storage before creating many entities or components at once
+    void ReserveEntities(size_t count) {
+        entities.reserve(entities.size() + count);
+    }
+    
+    template<typename T>
+    void ReserveComponents(size_t count) {
+        uint32_t typeId = Component::GetTypeId<T>();
+        auto& storage = GetOrCreateStorage<T>();
+        storage.Reserve(storage.Size() + count);
+        if (loggedAddTypes.test(typeId)) {
+            auto& records = addedComponents[typeId];
+            records.reserve(records.size() + count);
+        }
     }
     
+    // T is either derived from Component or a plain struct; plain structs are
+    // stored inline and should be trivially copyable so storage can memcpy them
     template<typename T, typename... Args>
     T* AddComponent(std::shared_ptr<Entity> entity, Args&&... args) {
+        static_assert(!std::is_empty_v<T>, "Empty types are marker tags; use AddTag");
         if (!entity || !entity->IsActive()) return nullptr;
         
         uint32_t typeId = Component::GetTypeId<T>();
-        auto component = std::make_unique<T>(std::forward<Args>(args)...);
-        T* ptr = component.get();
+        auto& storage = GetOrCreateStorage<T>();
         
-        components[typeId][entity->GetId()] = std::move(component);
+        // Built before the storage can grow, since args may refer into it
+        StoredComponent<T> component = MakeComponent<T>(std::forward<Args>(args)...);
+        
+        if constexpr (std::is_same_v<T, Tag>) {
+            UnindexTag(entity);
+        }
+        bool replaced = storage.IndexOf(entity->GetId()) != ComponentStorage::NONE;
+        void* slot = storage.Insert(entity->GetId(), changeTick);
+        new (slot) StoredComponent<T>(std::move(component));
+        T* ptr = ComponentAt<T>(slot);
+        if constexpr (IsBoxedComponent<T>) {
+            ptr->addedTick = storage.Ticks()[storage.IndexOf(entity->GetId())].added;
+            ptr->changedTick = changeTick;
+        }
         entity->AddComponentType(typeId);
+        // A replacement is a change, reported to observers as Set, not an add
+        if (!replaced && loggedAddTypes.test(typeId)) {
+            addedComponents[typeId].push_back({changeTick, entity});
+        }
+        if constexpr (std::is_same_v<T, Tag>) {
+            IndexTag(entity, *ptr);
+        }
+        QueueEvent(replaced ? ComponentEvent::Set : ComponentEvent::Add, typeId, entity);
         
         return ptr;
     }
     
+    // Creates count entities from the prefab. Each component type is appended
+    // to its storage in one step and filled with copies of the prefab's
+    // default, then initializer(PrefabInstance&) runs once per entity to set
+    // its own values. The initializer must not add or remove components of
+    // the prefab's types.
+    template<typename Initializer>
+    EntityList Instantiate(const Prefab& prefab, size_t count, Initializer&& initializer) {
+        EntityList created(GetFrameAllocator<std::shared_ptr<Entity>>());
+        if (count == 0) return created;
+        
+        created.reserve(count);
+        entities.reserve(entities.size() + count);
+        FrameVector<uint32_t> ids(GetFrameAllocator<uint32_t>());
+        ids.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto entity = std::make_shared<Entity>(nextEntityId++);
+            entity->AddComponentTypes(prefab.GetMask());
+            ids.push_back(entity->GetId());
+            entities.push_back(entity);
+            created.push_back(std::move(entity));
+        }
+        
+        std::array<ComponentStorage*, MAX_COMPONENTS> batchStorages = {};
+        std::array<uint32_t, MAX_COMPONENTS> firstIndex = {};
+        for (const auto& entry : prefab.entries) {
+            auto& storage = storages.at(entry.typeId);
+            if (!storage) {
+                storage = std::make_unique<ComponentStorage>(*entry.storedType);
+            }
+            firstIndex[entry.typeId] = storage->Append(ids.data(), count, changeTick);
+            entry.copyInto(storage->At(firstIndex[entry.typeId]), count, entry.value.get());
+            batchStorages[entry.typeId] = storage.get();
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            PrefabInstance instance(batchStorages.data(), firstIndex.data(), i, created[i]);
+            initializer(instance);
+        }
+        
+        std::bitset<MAX_COMPONENTS> observedAdds = prefab.GetMask() & observedTypes[static_cast<size_t>(ComponentEvent::Add)];
+        if (observedAdds.any()) {
+            for (uint32_t typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+                if (!observedAdds.test(typeId)) continue;
+                for (auto& entity : created) {
+                    QueueEvent(ComponentEvent::Add, typeId, entity);
+                }
+            }
+        }
+        
+        // After the initializer, which may have assigned whole components
+        uint32_t tagTypeId = Component::GetTypeId<Tag>();
+        for (const auto& entry : prefab.entries) {
+            if (loggedAddTypes.test(entry.typeId)) {
+                auto& records = addedComponents[entry.typeId];
+                records.reserve(records.size() + count);
+                for (size_t i = 0; i < count; ++i) {
+                    records.push_back({changeTick, created[i]});
+                }
+            }
+            if (!entry.boxed) continue;
+            
+            ComponentStorage& storage = *batchStorages[entry.typeId];
+            for (size_t i = 0; i < count; ++i) {
+                Component* component = static_cast<std::unique_ptr<Component>*>(
+                    storage.At(firstIndex[entry.typeId] + i))->get();
+                component->addedTick = changeTick;
+                component->changedTick = changeTick;
+                if (entry.typeId == tagTypeId) {
+                    IndexTag(created[i], static_cast<Tag&>(*component));
+                }
+            }
+        }
+        
+        return created;
+    }
+    
+    EntityList Instantiate(const Prefab& prefab, size_t count) {
+        return Instantiate(prefab, count, [](PrefabInstance&) {});
+    }
+    
+    // Bulk add for loaders: each of count distinct, active entities that has
+    // no T yet gets the component make(i) returns. batch[i] yields the i-th
+    // entity, so an EntityList, a pointer or an indexed view all work. T's
+    // storage grows once and the components are built in place, in order.
+    template<typename T, typename Batch, typename Make>
+    void AddComponents(const Batch& batch, size_t count, Make&& make) {
+        static_assert(!std::is_empty_v<T>, "Empty types are marker tags; use AddTag");
+        if (count == 0) return;
+        
+        uint32_t first = AppendSlots<T>(batch, count);
+        ComponentStorage& storage = *storages[Component::GetTypeId<T>()];
+        for (size_t i = 0; i < count; ++i) {
+            new (storage.At(first + i)) StoredComponent<T>(MakeComponent<T>(make(i)));
+        }
+        FinishAppend<T>(batch, count, first);
+    }
+    
+    // AddComponents for plain components, copied from an array with one memcpy
+    template<typename T, typename Batch>
+    void CopyComponents(const Batch& batch, size_t count, const T* values) {
+        static_assert(!IsBoxedComponent<T> && std::is_trivially_copyable_v<T>,
+                      "Only plain, trivially copyable components can be copied in bulk");
+        if (count == 0) return;
+        
+        uint32_t first = AppendSlots<T>(batch, count);
+        std::memcpy(storages[Component::GetTypeId<T>()]->At(first), values, count * sizeof(T));
+        FinishAppend<T>(batch, count, first);
+    }
+    
+    // Mutable access marks the component changed; use ReadComponent for reads
     template<typename T>
     T* GetComponent(std::shared_ptr<Entity> entity) {
-        if (!entity || !entity->IsActive()) return nullptr;
+        uint32_t index;
+        ComponentStorage* storage = Locate(Component::GetTypeId<T>(), entity, index);
+        if (!storage) return nullptr;
         
-        uint32_t typeId = Component::GetTypeId<T>();
-        auto it = components.find(typeId);
-        if (it == components.end()) return nullptr;
-        
-        auto compIt = it->second.find(entity->GetId());
-        if (compIt == it->second.end()) return nullptr;
+        return MarkChangedAt<T>(*storage, index);
+    }
+    
+    template<typename T>
+    const T* ReadComponent(std::shared_ptr<Entity> entity) const {
+        return FindComponent<T>(entity);
+    }
+    
+    template<typename T>
+    void MarkChanged(std::shared_ptr<Entity> entity) {
+        uint32_t index;
+        if (ComponentStorage* storage = Locate(Component::GetTypeId<T>(), entity, index)) {
+            MarkChangedAt<T>(*storage, index);
+        }
+    }
+    
+    // Added/changed ticks for any component type, zero if the entity lacks it
+    template<typename T>
+    ComponentTicks GetComponentTicks(const std::shared_ptr<Entity>& entity) const {
+        uint32_t index;
+        const ComponentStorage* storage = Locate(Component::GetTypeId<T>(), entity, index);
+        return storage ? storage->Ticks()[index] : ComponentTicks();
+    }
+    
+    // Marks every T changed, since the caller may write any of them
+    template<typename T>
+    ComponentArray<T> GetComponentArray() {
+        static_assert(!IsBoxedComponent<T>, "Only plain components are stored contiguously");
+        ComponentStorage* storage = storages.at(Component::GetTypeId<T>()).get();
+        if (!storage) return {};
         
-        return static_cast<T*>(compIt->second.get());
+        for (size_t i = 0; i < storage->Size(); ++i) {
+            storage->Ticks()[i].changed = changeTick;
+        }
+        return {static_cast<T*>(storage->Data()), storage->EntityIds(), storage->Size()};
+    }
+    
+    template<typename T>
+    ComponentArray<const T> ReadComponentArray() const {
+        static_assert(!IsBoxedComponent<T>, "Only plain components are stored contiguously");
+        const ComponentStorage* storage = storages.at(Component::GetTypeId<T>()).get();
+        if (!storage) return {};
+        return {static_cast<const T*>(storage->Data()), storage->EntityIds(), storage->Size()};
     }
     
     template<typename T>
@@ -71,9 +421,13 @@ public:
         if (!entity) return;
         
         uint32_t typeId = Component::GetTypeId<T>();
-        auto it = components.find(typeId);
-        if (it != components.end()) {
-            it->second.erase(entity->GetId());
+        if (ComponentStorage* storage = storages.at(typeId).get()) {
+            if constexpr (std::is_same_v<T, Tag>) {
+                UnindexTag(entity);
+            }
+            if (storage->Remove(entity->GetId())) {
+                QueueEvent(ComponentEvent::Remove, typeId, entity);
+            }
             entity->RemoveComponentType(typeId);
         }
     }
@@ -84,18 +438,301 @@ public:
         return entity->HasComponentType(Component::GetTypeId<T>());
     }
     
-    void AddSystem(std::unique_ptr<System> system) {
+    // Marker types are empty structs that exist only as a bit in the entity's
+    // component mask: no storage, but usable in query masks like components
+    template<typename T>
+    void AddTag(const std::shared_ptr<Entity>& entity) {
+        static_assert(std::is_empty_v<T>, "Marker tags must be empty types");
+        if (!entity || !entity->IsActive()) return;
+        uint32_t typeId = Component::GetTypeId<T>();
+        if (entity->HasComponentType(typeId)) return;
+        entity->AddComponentType(typeId);
+        QueueEvent(ComponentEvent::Add, typeId, entity);
+    }
+    
+    template<typename T>
+    void RemoveTag(const std::shared_ptr<Entity>& entity) {
+        static_assert(std::is_empty_v<T>, "Marker tags must be empty types");
+        uint32_t typeId = Component::GetTypeId<T>();
+        if (!entity || !entity->HasComponentType(typeId)) return;
+        entity->RemoveComponentType(typeId);
+        QueueEvent(ComponentEvent::Remove, typeId, entity);
+    }
+    
+    template<typename T>
+    bool HasTag(const std::shared_ptr<Entity>& entity) const {
+        return entity && entity->IsActive() && entity->HasComponentType(Component::GetTypeId<T>());
+    }
+    
+    // Relationship pairs: source has (R, target), e.g. AddPair<AttachedTo>(cube, player).
+    // Both directions are indexed, so GetTargets and GetSources cost only the
+    // size of their result. R is an empty type; the source carries R's mask
+    // bit while it has any R pair, so R works in query masks and observers.
+    // Each relation type therefore takes a component type id, and counts
+    // toward the MAX_COMPONENTS (64) ids shared with components and tags.
+    template<typename R>
+    bool AddPair(const std::shared_ptr<Entity>& source, const std::shared_ptr<Entity>& target) {
+        static_assert(std::is_empty_v<R>, "Relations are empty types; keep pair data in a component");
+        if (!source || !target || !source->IsActive() || !target->IsActive()) return false;
+        uint32_t typeId = Component::GetTypeId<R>();
+        RelationIndex& index = GetOrCreateRelation(typeId);
+        
+        auto& targets = index.targets[source->GetId()];
+        if (std::find(targets.begin(), targets.end(), target) != targets.end()) return false;
+        targets.push_back(target);
+        index.sources[target->GetId()].push_back(source);
+        
+        if (!source->HasComponentType(typeId)) {
+            source->AddComponentType(typeId);
+            QueueEvent(ComponentEvent::Add, typeId, source);
+        }
+        return true;
+    }
+    
+    // Makes target the source's only R target, for relations such as ownership
+    // that allow one. Reported to observers as a Set if the source had one.
+    template<typename R>
+    bool SetPair(const std::shared_ptr<Entity>& source, const std::shared_ptr<Entity>& target) {
+        static_assert(std::is_empty_v<R>, "Relations are empty types; keep pair data in a component");
+        if (!source || !target || !source->IsActive() || !target->IsActive()) return false;
+        uint32_t typeId = Component::GetTypeId<R>();
+        RelationIndex& index = GetOrCreateRelation(typeId);
+        
+        auto& targets = index.targets[source->GetId()];
+        if (targets.size() == 1 && targets.front() == target) return true;
+        for (auto& previous : targets) {
+            EraseSource(index, previous->GetId(), source);
+        }
+        targets.assign(1, target);
+        index.sources[target->GetId()].push_back(source);
+        
+        bool replaced = source->HasComponentType(typeId);
+        source->AddComponentType(typeId);
+        QueueEvent(replaced ? ComponentEvent::Set : ComponentEvent::Add, typeId, source);
+        return true;
+    }
+    
+    template<typename R>
+    bool RemovePair(const std::shared_ptr<Entity>& source, const std::shared_ptr<Entity>& target) {
+        uint32_t typeId = Component::GetTypeId<R>();
+        RelationIndex* index = relations.at(typeId).get();
+        if (!index || !source || !target) return false;
+        
+        auto it = index->targets.find(source->GetId());
+        if (it == index->targets.end()) return false;
+        auto& targets = it->second;
+        auto pos = std::find(targets.begin(), targets.end(), target);
+        if (pos == targets.end()) return false;
+        
+        targets.erase(pos);
+        EraseSource(*index, target->GetId(), source);
+        if (targets.empty()) {
+            index->targets.erase(it);
+            ClearRelationBit(typeId, source);
+        }
+        return true;
+    }
+    
+    // Removes every R pair the source has
+    template<typename R>
+    void RemovePairs(const std::shared_ptr<Entity>& source) {
+        uint32_t typeId = Component::GetTypeId<R>();
+        RelationIndex* index = relations.at(typeId).get();
+        if (!index || !source) return;
+        
+        auto it = index->targets.find(source->GetId());
+        if (it == index->targets.end()) return;
+        for (auto& target : it->second) {
+            EraseSource(*index, target->GetId(), source);
+        }
+        index->targets.erase(it);
+        ClearRelationBit(typeId, source);
+    }
+    
+    template<typename R>
+    bool HasPair(const std::shared_ptr<Entity>& source, const std::shared_ptr<Entity>& target) const {
+        const auto& targets = GetTargets<R>(source);
+        return std::find(targets.begin(), targets.end(), target) != targets.end();
+    }
+    
+    // The source's first R target, or null
+    template<typename R>
+    std::shared_ptr<Entity> GetTarget(const std::shared_ptr<Entity>& source) const {
+        const auto& targets = GetTargets<R>(source);
+        return targets.empty() ? nullptr : targets.front();
+    }
+    
+    // Everything the source has an R pair with, in the order the pairs were added
+    template<typename R>
+    const std::vector<std::shared_ptr<Entity>>& GetTargets(const std::shared_ptr<Entity>& source) const {
+        return FindRelationList(Component::GetTypeId<R>(), source, &RelationIndex::targets);
+    }
+    
+    // Every entity with an R pair targeting target: the children of a parent,
+    // the attackers of a unit. Invalidated by adding or removing R pairs.
+    template<typename R>
+    const std::vector<std::shared_ptr<Entity>>& GetSources(const std::shared_ptr<Entity>& target) const {
+        return FindRelationList(Component::GetTypeId<R>(), target, &RelationIndex::sources);
+    }
+    
+    // Defaults to RemovePair
+    template<typename R>
+    void SetRelationCleanup(RelationCleanup cleanup) {
+        GetOrCreateRelation(Component::GetTypeId<R>()).cleanup = cleanup;
+    }
+    
+    // Entities whose Tag component has this id, e.g. GetEntitiesWithTag(Tags::Player).
+    // The reference is invalidated by adding or removing a Tag with the same id.
+    const std::vector<std::shared_ptr<Entity>>& GetEntitiesWithTag(TagId id) {
+        static const std::vector<std::shared_ptr<Entity>> none;
+        auto it = taggedEntities.find(id);
+        if (it == taggedEntities.end()) return none;
+        
+        profiler.AddEntityCount(it->second.size());
+        return it->second;
+    }
+    
+    std::shared_ptr<Entity> FindEntityWithTag(TagId id) const {
+        auto it = taggedEntities.find(id);
+        if (it == taggedEntities.end() || it->second.empty()) return nullptr;
+        return it->second.front();
+    }
+    
+    // Registered under T, so GetSystem<T> and DependsOn(T*&) find it without a
+    // scan; pass the concrete type rather than a std::unique_ptr<System>
+    template<typename T>
+    T* AddSystem(std::unique_ptr<T> system) {
+        static_assert(std::is_base_of_v<System, T>, "AddSystem takes a System");
         system->SetWorld(this);
+        if (system->GetName().empty()) {
+            system->SetName(SystemTypeName(*system));
+        }
+        if (!ResolveSystemGroup(*system)) {
+            ECS_LOG_WARNING("System {} is in unknown group '{}', running it every frame until the group is added",
+                            Logger::Persist(system->GetName()), Logger::Persist(system->GetGroup()));
+        }
+        T* added = system.get();
+        if constexpr (!std::is_same_v<T, System>) {
+            uint32_t typeId = System::GetTypeId<T>();
+            if (typeId >= systemsByType.size()) {
+                systemsByType.resize(typeId + 1, nullptr);
+            }
+            if (!systemsByType[typeId]) {
+                systemsByType[typeId] = added;
+            }
+        }
         systems.push_back(std::move(system));
+        profiler.ReserveSystems(systems.size());
+        ResolveDependencies();
+        added->OnAddedToWorld();
         
         std::sort(systems.begin(), systems.end(),
             [](const auto& a, const auto& b) {
                 return a->GetPriority() < b->GetPriority();
             });
+        return added;
+    }
+    
+    // Adds a group, or changes the rate of an existing one. Systems join a
+    // group with System::SetGroup before they are added.
+    void AddSystemGroup(const std::string& name, float tickRate, uint32_t maxStepsPerFrame = 4) {
+        auto it = std::find_if(systemGroups.begin(), systemGroups.end(),
+            [&name](const SystemGroup& group) { return group.name == name; });
+        if (it == systemGroups.end()) {
+            SystemGroup group;
+            group.name = name;
+            it = systemGroups.insert(systemGroups.end(), group);
+        }
+        it->tickRate = tickRate;
+        it->maxStepsPerFrame = std::max<uint32_t>(maxStepsPerFrame, 1);
+        
+        for (auto& system : systems) {
+            ResolveSystemGroup(*system);
+        }
+    }
+    
+    const SystemGroup* GetSystemGroup(const std::string& name) const {
+        for (const auto& group : systemGroups) {
+            if (group.name == name) return &group;
+        }
+        return nullptr;
+    }
+    
+    // Observers are called with every entity whose T was added, replaced or
+    // removed since the last flush. Events are batched and delivered at sync
+    // points: before each system runs, at the end of Update, and on
+    // FlushObservers. Removals are delivered first, after the component is
+    // already gone. An add or replacement undone before the flush is dropped.
+    template<typename T>
+    ObserverId OnAdd(ObserverCallback callback) {
+        return AddObserver(ComponentEvent::Add, Component::GetTypeId<T>(), std::move(callback));
+    }
+    
+    template<typename T>
+    ObserverId OnSet(ObserverCallback callback) {
+        return AddObserver(ComponentEvent::Set, Component::GetTypeId<T>(), std::move(callback));
+    }
+    
+    template<typename T>
+    ObserverId OnRemove(ObserverCallback callback) {
+        return AddObserver(ComponentEvent::Remove, Component::GetTypeId<T>(), std::move(callback));
+    }
+    
+    void RemoveObserver(ObserverId id) {
+        for (auto& observer : observers) {
+            if (observer.id == id) observer.removed = true;
+        }
+        if (!flushingObservers) {
+            CompactObservers();
+        }
+    }
+    
+    // Delivers pending events, including ones raised by the callbacks themselves
+    void FlushObservers() {
+        if (flushingObservers) return;
+        flushingObservers = true;
+        
+        while (eventsPending) {
+            eventsPending = false;
+            for (size_t event = 0; event < COMPONENT_EVENT_COUNT; ++event) {
+                for (uint32_t typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+                    auto& pending = pendingEvents[event * MAX_COMPONENTS + typeId];
+                    if (pending.empty()) continue;
+                    
+                    EntityList batch(GetFrameAllocator<std::shared_ptr<Entity>>());
+                    batch.reserve(pending.size());
+                    for (auto& entity : pending) {
+                        if (event == static_cast<size_t>(ComponentEvent::Remove) ||
+                            (entity->IsActive() && entity->HasComponentType(typeId))) {
+                            batch.push_back(std::move(entity));
+                        }
+                    }
+                    pending.clear();
+                    if (batch.empty()) continue;
+                    
+                    // Callbacks may add observers; a deque keeps this one in place
+                    for (size_t i = 0; i < observers.size(); ++i) {
+                        Observer& observer = observers[i];
+                        if (static_cast<size_t>(observer.event) == event && observer.typeId == typeId && !observer.removed) {
+                            observer.callback(batch);
+                        }
+                    }
+                }
+            }
+        }
+        
+        flushingObservers = false;
+        CompactObservers();
     }
     
+    // The first T added. Systems added under their own type are found in
+    // constant time; asking for a base class falls back to a scan.
     template<typename T>
     T* GetSystem() {
+        uint32_t typeId = System::GetTypeId<T>();
+        if (typeId < systemsByType.size() && systemsByType[typeId]) {
+            return static_cast<T*>(systemsByType[typeId]);
+        }
         for (auto& system : systems) {
             if (auto* s = dynamic_cast<T*>(system.get())) {
                 return s;
@@ -104,19 +741,165 @@ public:
         return nullptr;
     }
     
+    // Creates or replaces the world's T. Resources hold global state outside
+    // entity storage, so reaching one is an array lookup rather than a query.
+    template<typename T, typename... Args>
+    T& SetResource(Args&&... args) {
+        std::shared_ptr<T> resource;
+        if constexpr (std::is_constructible_v<T, Args...>) {
+            resource = std::make_shared<T>(std::forward<Args>(args)...);
+        } else {
+            resource = std::make_shared<T>(T{std::forward<Args>(args)...});
+        }
+        T& result = *resource;
+        resources.at(Resource::GetTypeId<T>()) = std::move(resource);
+        return result;
+    }
+    
+    // Null if no T was set. Systems declare the access with
+    // System::WritesResources and ReadsResources.
+    template<typename T>
+    T* GetResource() {
+        uint32_t typeId = Resource::GetTypeId<T>();
+        CheckResourceAccess<T>(typeId, true);
+        return static_cast<T*>(resources.at(typeId).get());
+    }
+    
+    template<typename T>
+    const T* ReadResource() const {
+        uint32_t typeId = Resource::GetTypeId<T>();
+        CheckResourceAccess<T>(typeId, false);
+        return static_cast<const T*>(resources.at(typeId).get());
+    }
+    
+    template<typename T>
+    bool HasResource() const {
+        return resources.at(Resource::GetTypeId<T>()) != nullptr;
+    }
+    
+    template<typename T>
+    void RemoveResource() {
+        resources.at(Resource::GetTypeId<T>()).reset();
+    }
+    
     void Update(float deltaTime) {
-        for (auto& system : systems) {
-            if (system->IsEnabled()) {
-                system->PreUpdate(deltaTime);
-                system->Update(deltaTime);
-                system->PostUpdate(deltaTime);
+        uint32_t frameStart = changeTick;
+        profiler.BeginFrame();
+        inFrame = true;
+        
+        if (auto* time = static_cast<Time*>(resources[Resource::GetTypeId<Time>()].get())) {
+            time->deltaTime = deltaTime;
+            time->elapsed += deltaTime;
+            time->frameCount++;
+        }
+        
+        for (auto& group : systemGroups) {
+            AdvanceSystemGroup(group, deltaTime);
+        }
+        
+        for (size_t i = 0; i < systems.size(); ++i) {
+            auto& system = systems[i];
+            const SystemGroup& group = systemGroups[system->groupIndex];
+            if (!system->IsEnabled() || group.stepsThisFrame == 0) continue;
+            
+            float stepTime = group.GetStepTime(deltaTime);
+            profiler.BeginSystem(i, system->GetName());
+            for (uint32_t step = 0; step < group.stepsThisFrame; ++step) {
+                if (eventsPending) FlushObservers();
+                uint32_t thisRun = ++changeTick;
+                system->AdvanceStagger(stepTime);
+                
+                runningSystem = system.get();
+                profiler.BeginPhase(SystemPhase::PreUpdate);
+                system->PreUpdate(stepTime);
+                profiler.EndPhase();
+                
+                profiler.BeginPhase(SystemPhase::Update);
+                system->Update(stepTime);
+                profiler.EndPhase();
+                
+                profiler.BeginPhase(SystemPhase::PostUpdate);
+                system->PostUpdate(stepTime);
+                profiler.EndPhase();
+                runningSystem = nullptr;
+                
+                system->SetLastRunTick(thisRun);
+            }
+            profiler.EndSystem();
+        }
+        
+        FlushObservers();
+        
+        // Changes made between frames must compare newer than every system's last run
+        ++changeTick;
+        
+        // Drop records every enabled system has already run past. Systems in
+        // slow groups may not have run this frame, so it is not enough to
+        // compare with frameStart.
+        uint32_t oldestRun = OldestSystemRun(frameStart);
+        for (auto& [typeId, records] : addedComponents) {
+            records.erase(
+                std::remove_if(records.begin(), records.end(),
+                    [oldestRun](const AddedRecord& r) { return r.tick <= oldestRun; }),
+                records.end()
+            );
+        }
+        
+        // Rewinds this thread's arena now; pool workers rewind on first use next frame
+        inFrame = false;
+        frameKey = FrameArena::NewFrameKey();
+        FrameArena::ForThread(frameKey);
+        
+        profiler.EndFrame();
+    }
+    
+    FrameProfiler& GetProfiler() { return profiler; }
+    const FrameProfiler& GetProfiler() const { return profiler; }
+    
+    uint32_t GetChangeTick() const { return changeTick; }
+    
+    // Scratch memory for the current frame, one arena per thread. What a pool
+    // worker allocates inside a job may be reused by another World once the
+    // job returns, so hand results back in memory the caller owns.
+    FrameArena& GetFrameArena() { return FrameArena::ForThread(frameKey); }
+    
+    // Allocates from the frame arena during Update and from the heap otherwise,
+    // so queries made between frames stay valid
+    template<typename T>
+    FrameAllocator<T> GetFrameAllocator() {
+        return FrameAllocator<T>(inFrame ? &GetFrameArena() : nullptr);
+    }
+    
+    // Entities that received component T after sinceTick (typically the calling
+    // system's GetLastRunTick()). Records are kept until every system has had a
+    // chance to see them, so a tick older than the previous frame may miss some.
+    // Adds are only logged for types asked about here; the first call for a
+    // type seeds the log from the storage's ticks.
+    template<typename T>
+    EntityList GetEntitiesWithAddedComponent(uint32_t sinceTick) {
+        EntityList result(GetFrameAllocator<std::shared_ptr<Entity>>());
+        
+        uint32_t typeId = Component::GetTypeId<T>();
+        if (!loggedAddTypes.test(typeId)) {
+            loggedAddTypes.set(typeId);
+            SeedAddedRecords(typeId, OldestSystemRun(sinceTick));
+        }
+        
+        auto it = addedComponents.find(typeId);
+        if (it == addedComponents.end()) return result;
+        
+        for (auto& record : it->second) {
+            if (record.tick > sinceTick && record.entity->IsActive()) {
+                result.push_back(record.entity);
             }
         }
+        
+        profiler.AddEntityCount(result.size());
+        return result;
     }
     
-    std::vector<std::shared_ptr<Entity>> GetEntitiesWithComponents(
-        const std::bitset<MAX_COMPONENTS>& componentMask) {
-        std::vector<std::shared_ptr<Entity>> result;
+    EntityList GetEntitiesWithComponents(const std::bitset<MAX_COMPONENTS>& componentMask) {
+        EntityList result(GetFrameAllocator<std::shared_ptr<Entity>>());
         
         for (auto& entity : entities) {
             if (entity->IsActive() && 
@@ -125,6 +908,36 @@ public:
             }
         }
         
+        profiler.AddEntityCount(result.size());
+        return result;
+    }
+    
+    // Entities matching the mask whose filtered components were added or
+    // changed after sinceTick, e.g.
+    //   GetEntitiesWithComponents<Changed<Transform>>(mask, GetLastRunTick())
+    template<typename... Filters>
+    EntityList GetEntitiesWithComponents(const std::bitset<MAX_COMPONENTS>& componentMask, uint32_t sinceTick) {
+        std::bitset<MAX_COMPONENTS> mask = componentMask;
+        (mask.set(Component::GetTypeId<typename Filters::ComponentType>()), ...);
+        
+        EntityList result(GetFrameAllocator<std::shared_ptr<Entity>>());
+        
+        // The mask guarantees each filtered component exists
+        auto ticksOf = [this](uint32_t typeId, uint32_t entityId) -> const ComponentTicks& {
+            const ComponentStorage& storage = *storages[typeId];
+            return storage.Ticks()[storage.IndexOf(entityId)];
+        };
+        
+        for (auto& entity : entities) {
+            if (entity->IsActive() && 
+                (entity->GetComponentMask() & mask) == mask &&
+                (Filters::Matches(ticksOf(Component::GetTypeId<typename Filters::ComponentType>(), entity->GetId()),
+                                  sinceTick) && ...)) {
+                result.push_back(entity);
+            }
+        }
+        
+        profiler.AddEntityCount(result.size());
         return result;
     }
     
@@ -134,16 +947,448 @@ public:
     
     void Clear() {
         entities.clear();
-        components.clear();
+        for (auto& storage : storages) {
+            storage.reset();
+        }
+        addedComponents.clear();
+        loggedAddTypes.reset();
+        taggedEntities.clear();
+        for (auto& relation : relations) {
+            relation.reset();
+        }
+        relationTypeIds.clear();
         systems.clear();
+        systemsByType.clear();
+        for (auto& resource : resources) {
+            resource.reset();
+        }
+        SetResource<Time>();
+        observers.clear();
+        for (auto& types : observedTypes) {
+            types.reset();
+        }
+        for (auto& pending : pendingEvents) {
+            pending.clear();
+        }
+        eventsPending = false;
         nextEntityId = 1;
+        profiler.Reset();
     }
-    
+
 private:
+    template<typename T>
+    ComponentStorage& GetOrCreateStorage() {
+        auto& storage = storages.at(Component::GetTypeId<T>());
+        if (!storage) {
+            storage = std::make_unique<ComponentStorage>(ComponentTypeInfo::Of<StoredComponent<T>>());
+        }
+        return *storage;
+    }
+    
+    // Storage holding the entity's component of this type, and its index there
+    ComponentStorage* Locate(uint32_t typeId, const std::shared_ptr<Entity>& entity, uint32_t& index) const {
+        if (!entity || !entity->IsActive() || typeId >= MAX_COMPONENTS) return nullptr;
+        
+        ComponentStorage* storage = storages[typeId].get();
+        if (!storage) return nullptr;
+        
+        index = storage->IndexOf(entity->GetId());
+        return index != ComponentStorage::NONE ? storage : nullptr;
+    }
+    
+    template<typename T>
+    T* FindComponent(const std::shared_ptr<Entity>& entity) const {
+        uint32_t index;
+        ComponentStorage* storage = Locate(Component::GetTypeId<T>(), entity, index);
+        return storage ? ComponentAt<T>(storage->At(index)) : nullptr;
+    }
+    
+    template<typename T, typename... Args>
+    static StoredComponent<T> MakeComponent(Args&&... args) {
+        if constexpr (IsBoxedComponent<T>) {
+            return std::make_unique<T>(std::forward<Args>(args)...);
+        } else if constexpr (std::is_constructible_v<T, Args...>) {
+            return T(std::forward<Args>(args)...);
+        } else {
+            return T{std::forward<Args>(args)...};
+        }
+    }
+    
+    // Uninitialised T slots for a batch of entities that have no T yet
+    template<typename T, typename Batch>
+    uint32_t AppendSlots(const Batch& batch, size_t count) {
+        FrameVector<uint32_t> ids(GetFrameAllocator<uint32_t>());
+        ids.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            ids.push_back(batch[i]->GetId());
+        }
+        return GetOrCreateStorage<T>().Append(ids.data(), count, changeTick);
+    }
+    
+    // Bookkeeping for slots filled after AppendSlots
+    template<typename T, typename Batch>
+    void FinishAppend(const Batch& batch, size_t count, uint32_t first) {
+        uint32_t typeId = Component::GetTypeId<T>();
+        ComponentStorage& storage = *storages[typeId];
+        for (size_t i = 0; i < count; ++i) {
+            batch[i]->AddComponentType(typeId);
+            if constexpr (IsBoxedComponent<T>) {
+                T* component = ComponentAt<T>(storage.At(first + i));
+                component->addedTick = changeTick;
+                component->changedTick = changeTick;
+                if constexpr (std::is_same_v<T, Tag>) {
+                    IndexTag(batch[i], *component);
+                }
+            }
+        }
+        
+        if (loggedAddTypes.test(typeId)) {
+            auto& records = addedComponents[typeId];
+            records.reserve(records.size() + count);
+            for (size_t i = 0; i < count; ++i) {
+                records.push_back({changeTick, batch[i]});
+            }
+        }
+        if (observedTypes[static_cast<size_t>(ComponentEvent::Add)].test(typeId)) {
+            for (size_t i = 0; i < count; ++i) {
+                QueueEvent(ComponentEvent::Add, typeId, batch[i]);
+            }
+        }
+    }
+    
+    template<typename T>
+    static T* ComponentAt(void* slot) {
+        if constexpr (IsBoxedComponent<T>) {
+            return static_cast<T*>(static_cast<std::unique_ptr<Component>*>(slot)->get());
+        } else {
+            return static_cast<T*>(slot);
+        }
+    }
+    
+    template<typename T>
+    T* MarkChangedAt(ComponentStorage& storage, uint32_t index) {
+        storage.Ticks()[index].changed = changeTick;
+        T* component = ComponentAt<T>(storage.At(index));
+        if constexpr (IsBoxedComponent<T>) {
+            component->changedTick = changeTick;
+        }
+        return component;
+    }
+    
+    uint32_t OldestSystemRun(uint32_t bound) const {
+        for (const auto& system : systems) {
+            if (system->IsEnabled()) {
+                bound = std::min(bound, system->GetLastRunTick());
+            }
+        }
+        return bound;
+    }
+    
+    // Logs the components of this type added after sinceTick
+    void SeedAddedRecords(uint32_t typeId, uint32_t sinceTick) {
+        const ComponentStorage* storage = storages[typeId].get();
+        if (!storage) return;
+        
+        auto& records = addedComponents[typeId];
+        for (auto& entity : entities) {
+            if (!entity->IsActive() || !entity->HasComponentType(typeId)) continue;
+            uint32_t added = storage->Ticks()[storage->IndexOf(entity->GetId())].added;
+            if (added > sinceTick) records.push_back({added, entity});
+        }
+    }
+    
+    void IndexTag(const std::shared_ptr<Entity>& entity, Tag& tag) {
+        auto& bucket = taggedEntities[tag.id];
+        tag.indexSlot = static_cast<uint32_t>(bucket.size());
+        bucket.push_back(entity);
+    }
+    
+    // Swap-removes the entity from its tag's bucket; must run while the entity is active
+    void UnindexTag(const std::shared_ptr<Entity>& entity) {
+        auto* tag = FindComponent<Tag>(entity);
+        if (!tag) return;
+        
+        auto& bucket = taggedEntities[tag->id];
+        if (tag->indexSlot + 1 != bucket.size()) {
+            bucket[tag->indexSlot] = std::move(bucket.back());
+            FindComponent<Tag>(bucket[tag->indexSlot])->indexSlot = tag->indexSlot;
+        }
+        bucket.pop_back();
+    }
+    
+    static std::string SystemTypeName(const System& system) {
+        std::string typeName = typeid(system).name();
+#ifdef __GNUG__
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(typeName.c_str(), nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            typeName = demangled;
+        }
+        std::free(demangled);
+#endif
+        for (const char* prefix : { "class ", "struct ", "ECS::" }) {
+            if (typeName.compare(0, std::char_traits<char>::length(prefix), prefix) == 0) {
+                typeName.erase(0, std::char_traits<char>::length(prefix));
+            }
+        }
+        return typeName;
+    }
+    
+    struct Observer {
+        ObserverId id;
+        ComponentEvent event;
+        uint32_t typeId;
+        ObserverCallback callback;
+        bool removed;   // Erased after the flush in progress, if any
+    };
+    
+    ObserverId AddObserver(ComponentEvent event, uint32_t typeId, ObserverCallback callback) {
+        ObserverId id = nextObserverId++;
+        observers.push_back({id, event, typeId, std::move(callback), false});
+        observedTypes[static_cast<size_t>(event)].set(typeId);
+        return id;
+    }
+    
+    void CompactObservers() {
+        observers.erase(
+            std::remove_if(observers.begin(), observers.end(),
+                [](const Observer& o) { return o.removed; }),
+            observers.end()
+        );
+        for (auto& types : observedTypes) {
+            types.reset();
+        }
+        for (const auto& observer : observers) {
+            observedTypes[static_cast<size_t>(observer.event)].set(observer.typeId);
+        }
+    }
+    
+    // Cheap when nothing observes the event: a single bit test
+    void QueueEvent(ComponentEvent event, uint32_t typeId, const std::shared_ptr<Entity>& entity) {
+        if (!observedTypes[static_cast<size_t>(event)].test(typeId)) return;
+        pendingEvents[static_cast<size_t>(event) * MAX_COMPONENTS + typeId].push_back(entity);
+        eventsPending = true;
+    }
+    
+    void QueueRemoveEvents(const std::shared_ptr<Entity>& entity) {
+        std::bitset<MAX_COMPONENTS> observed =
+            entity->GetComponentMask() & observedTypes[static_cast<size_t>(ComponentEvent::Remove)];
+        if (observed.none()) return;
+        for (uint32_t typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+            if (observed.test(typeId)) {
+                pendingEvents[static_cast<size_t>(ComponentEvent::Remove) * MAX_COMPONENTS + typeId].push_back(entity);
+            }
+        }
+        eventsPending = true;
+    }
+    
+    using RelationList = std::vector<std::shared_ptr<Entity>>;
+    
+    // One relation type's pairs, by entity id in both directions
+    struct RelationIndex {
+        RelationCleanup cleanup = RelationCleanup::RemovePair;
+        std::unordered_map<uint32_t, RelationList> targets;   // Source id -> its targets
+        std::unordered_map<uint32_t, RelationList> sources;   // Target id -> entities targeting it
+    };
+    
+    RelationIndex& GetOrCreateRelation(uint32_t typeId) {
+        auto& index = relations.at(typeId);
+        if (!index) {
+            index = std::make_unique<RelationIndex>();
+            relationTypeIds.push_back(typeId);
+        }
+        return *index;
+    }
+    
+    const RelationList& FindRelationList(uint32_t typeId, const std::shared_ptr<Entity>& entity,
+                                         std::unordered_map<uint32_t, RelationList> RelationIndex::*side) const {
+        static const RelationList none;
+        const RelationIndex* index = relations.at(typeId).get();
+        if (!index || !entity) return none;
+        auto it = (index->*side).find(entity->GetId());
+        return it == (index->*side).end() ? none : it->second;
+    }
+    
+    static void EraseSource(RelationIndex& index, uint32_t targetId, const std::shared_ptr<Entity>& source) {
+        auto it = index.sources.find(targetId);
+        if (it == index.sources.end()) return;
+        auto& sources = it->second;
+        sources.erase(std::remove(sources.begin(), sources.end(), source), sources.end());
+        if (sources.empty()) {
+            index.sources.erase(it);
+        }
+    }
+    
+    void ClearRelationBit(uint32_t typeId, const std::shared_ptr<Entity>& source) {
+        source->RemoveComponentType(typeId);
+        QueueEvent(ComponentEvent::Remove, typeId, source);
+    }
+    
+    // Extends a destroy batch with the sources of DestroySource relations,
+    // transitively. Marks them in destroyMarks like the rest of the batch.
+    void AddDestroyedSources(EntityList& doomed) {
+        for (size_t i = 0; i < doomed.size(); ++i) {
+            uint32_t id = doomed[i]->GetId();
+            for (uint32_t typeId : relationTypeIds) {
+                const RelationIndex& index = *relations[typeId];
+                if (index.cleanup != RelationCleanup::DestroySource) continue;
+                auto it = index.sources.find(id);
+                if (it == index.sources.end()) continue;
+                for (auto& source : it->second) {
+                    if (!source->IsActive() || destroyMarks[source->GetId()]) continue;
+                    destroyMarks[source->GetId()] = 1;
+                    doomed.push_back(source);
+                }
+            }
+        }
+    }
+    
+    // Drops the pairs of destroyed entities. A survivor on the other side of
+    // a pair has its list compacted once per batch, so releasing many pairs
+    // of one entity stays linear.
+    void UnlinkDestroyed(const EntityList& doomed) {
+        auto isDestroyed = [this](const std::shared_ptr<Entity>& e) { return destroyMarks[e->GetId()] != 0; };
+        
+        for (uint32_t typeId : relationTypeIds) {
+            RelationIndex& index = *relations[typeId];
+            if (index.targets.empty()) continue;
+            
+            FrameVector<uint32_t> survivingTargets(GetFrameAllocator<uint32_t>());
+            EntityList survivingSources(GetFrameAllocator<std::shared_ptr<Entity>>());
+            for (auto& entity : doomed) {
+                auto targetsIt = index.targets.find(entity->GetId());
+                if (targetsIt != index.targets.end()) {
+                    for (auto& target : targetsIt->second) {
+                        if (!isDestroyed(target)) survivingTargets.push_back(target->GetId());
+                    }
+                    index.targets.erase(targetsIt);
+                }
+                
+                auto sourcesIt = index.sources.find(entity->GetId());
+                if (sourcesIt != index.sources.end()) {
+                    for (auto& source : sourcesIt->second) {
+                        if (!isDestroyed(source)) survivingSources.push_back(source);
+                    }
+                    index.sources.erase(sourcesIt);
+                }
+            }
+            
+            std::sort(survivingTargets.begin(), survivingTargets.end());
+            survivingTargets.erase(std::unique(survivingTargets.begin(), survivingTargets.end()), survivingTargets.end());
+            for (uint32_t id : survivingTargets) {
+                auto it = index.sources.find(id);
+                auto& sources = it->second;
+                sources.erase(std::remove_if(sources.begin(), sources.end(), isDestroyed), sources.end());
+                if (sources.empty()) index.sources.erase(it);
+            }
+            
+            std::sort(survivingSources.begin(), survivingSources.end());
+            survivingSources.erase(std::unique(survivingSources.begin(), survivingSources.end()), survivingSources.end());
+            for (auto& source : survivingSources) {
+                auto it = index.targets.find(source->GetId());
+                auto& targets = it->second;
+                targets.erase(std::remove_if(targets.begin(), targets.end(), isDestroyed), targets.end());
+                if (targets.empty()) {
+                    index.targets.erase(it);
+                    ClearRelationBit(typeId, source);
+                }
+            }
+        }
+    }
+    
+    // Reports each undeclared resource once per system. Release builds skip
+    // the check; access outside a system run is never checked.
+    template<typename T>
+    void CheckResourceAccess(uint32_t typeId, bool write) const {
+#ifndef NDEBUG
+        if (!runningSystem) return;
+        bool declared = runningSystem->resourceWrites.test(typeId) ||
+                        (!write && runningSystem->resourceReads.test(typeId));
+        if (declared || runningSystem->undeclaredResourcesReported.test(typeId)) return;
+        runningSystem->undeclaredResourcesReported.set(typeId);
+        // Mangled names, since the logger formats later and needs strings that outlive the call
+        ECS_LOG_WARNING("System {} {} resource {} without declaring it",
+                        typeid(*runningSystem).name(), write ? "writes" : "reads", typeid(T).name());
+#else
+        (void)typeId;
+        (void)write;
+#endif
+    }
+    
+    // Cheap enough to redo for every system on each AddSystem: one indexed
+    // lookup per dependency, unless it names a base class
+    void ResolveDependencies() {
+        for (auto& system : systems) {
+            for (auto& dependency : system->dependencies) {
+                System* registered = dependency.typeId < systemsByType.size() ? systemsByType[dependency.typeId] : nullptr;
+                if (dependency.assign(dependency.slot, registered)) continue;
+                for (auto& candidate : systems) {
+                    if (dependency.assign(dependency.slot, candidate.get())) break;
+                }
+            }
+        }
+    }
+    
+    bool ResolveSystemGroup(System& system) {
+        for (size_t i = 0; i < systemGroups.size(); ++i) {
+            if (systemGroups[i].name == system.GetGroup()) {
+                system.groupIndex = i;
+                return true;
+            }
+        }
+        system.groupIndex = 0;
+        return false;
+    }
+    
+    static void AdvanceSystemGroup(SystemGroup& group, float deltaTime) {
+        if (group.tickRate <= 0.0f) {
+            group.stepsThisFrame = 1;
+            return;
+        }
+        
+        float stepTime = group.GetStepTime(deltaTime);
+        group.accumulator += deltaTime;
+        group.stepsThisFrame = 0;
+        while (group.accumulator >= stepTime && group.stepsThisFrame < group.maxStepsPerFrame) {
+            group.accumulator -= stepTime;
+            group.stepsThisFrame++;
+        }
+        
+        // Too far behind to catch up: drop the backlog instead of spiralling
+        if (group.accumulator >= stepTime) {
+            group.accumulator = std::fmod(group.accumulator, stepTime);
+        }
+    }
+    
+    struct AddedRecord {
+        uint32_t tick;
+        std::shared_ptr<Entity> entity;
+    };
+    
     uint32_t nextEntityId;
+    uint32_t changeTick;
+    uint64_t frameKey;
+    bool inFrame = false;
     std::vector<std::shared_ptr<Entity>> entities;
-    std::unordered_map<uint32_t, std::unordered_map<uint32_t, std::unique_ptr<Component>>> components;
+    std::vector<uint8_t> destroyMarks;  // By entity id; set only while DestroyEntities runs
+    std::array<std::unique_ptr<ComponentStorage>, MAX_COMPONENTS> storages;  // Indexed by type id
+    std::unordered_map<uint32_t, std::vector<AddedRecord>> addedComponents;
+    std::bitset<MAX_COMPONENTS> loggedAddTypes;   // Types GetEntitiesWithAddedComponent was asked for
+    std::unordered_map<TagId, std::vector<std::shared_ptr<Entity>>> taggedEntities;
+    std::array<std::unique_ptr<RelationIndex>, MAX_COMPONENTS> relations;   // By the relation's type id
+    std::vector<uint32_t> relationTypeIds;                                  // Those with an index
     std::vector<std::unique_ptr<System>> systems;
+    std::vector<System*> systemsByType;   // By System::GetTypeId, the first system added as each type
+    System* runningSystem = nullptr;      // During its PreUpdate, Update and PostUpdate
+    std::array<std::shared_ptr<void>, MAX_RESOURCES> resources;   // By Resource::GetTypeId
+    std::vector<SystemGroup> systemGroups;
+    std::deque<Observer> observers;
+    std::array<std::bitset<MAX_COMPONENTS>, COMPONENT_EVENT_COUNT> observedTypes;
+    std::array<std::vector<std::shared_ptr<Entity>>, COMPONENT_EVENT_COUNT * MAX_COMPONENTS> pendingEvents;
+    ObserverId nextObserverId = 1;
+    bool eventsPending = false;
+    bool flushingObservers = false;
+    FrameProfiler profiler;
 };
 
 }
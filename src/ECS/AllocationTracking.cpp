@@ -0,0 +1,57 @@
+#include "ECS/AllocationCounter.h"
+
+#ifdef ECS_TRACK_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* CountedAlloc(std::size_t size) {
+    ECS::AllocationCounter::Increment();
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* CountedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    ECS::AllocationCounter::Increment();
+    std::size_t align = static_cast<std::size_t>(alignment);
+    size = size ? (size + align - 1) / align * align : align;
+#ifdef _WIN32
+    void* ptr = _aligned_malloc(size, align);
+#else
+    void* ptr = std::aligned_alloc(align, size);
+#endif
+    if (ptr) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void AlignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return CountedAlignedAlloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return CountedAlignedAlloc(size, alignment); }
+void operator delete(void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { AlignedFree(ptr); }
+
+#endif
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include "ECS/Component.h"
 
 namespace ECS {
-    uint32_t Component::nextTypeId = 0;
+    std::atomic<uint32_t> Component::nextTypeId{0};
 }
\ No newline at end of file
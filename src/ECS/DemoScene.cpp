@@ -0,0 +1,78 @@
+#include "ECS/DemoScene.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/Velocity.h"
+#include "ECS/Components/Renderable.h"
+#include "ECS/Components/Input.h"
+#include "ECS/Components/Tag.h"
+#include "ECS/Components/RigidBody.h"
+#include "ECS/Components/Collider.h"
+
+namespace ECS {
+
+std::shared_ptr<Entity> CreateDemoScene(World& world, std::mt19937& gen, int cubeCount) {
+    // Create player entity with physics
+    auto player = world.CreateEntity();
+    world.AddComponent<Transform>(player, 
+        Transform(glm::vec3(0.0f, 5.0f, 0.0f)));
+    world.AddComponent<Velocity>(player, Velocity());
+    world.AddComponent<Renderable>(player, 
+        Renderable(MeshType::Cube, glm::vec3(0.2f, 0.8f, 0.2f)));
+    world.AddComponent<RigidBody>(player, 
+        RigidBody(1.0f, RigidBodyType::Dynamic));
+    world.AddComponent<Collider>(player, 
+        Collider::Box(glm::vec3(1.0f, 1.0f, 1.0f)));
+    world.AddComponent<Input>(player, Input());
+    world.AddComponent<Tag>(player, Tag("Player"));
+    
+    // Create random cubes
+    std::uniform_real_distribution<> posDistX(-40.0f, 40.0f);
+    std::uniform_real_distribution<> posDistY(-15.0f, 15.0f);
+    std::uniform_real_distribution<> posDistZ(-40.0f, 40.0f);
+    std::uniform_real_distribution<> velDist(-5.0f, 5.0f);
+    std::uniform_real_distribution<> angVelDist(-1.0f, 1.0f);
+    std::uniform_real_distribution<> scaleDist(0.5f, 2.0f);
+    std::uniform_real_distribution<> colorDist(0.3f, 1.0f);
+    
+    // Defaults shared by every cube; the initializer fills in the random parts
+    Prefab cubePrefab;
+    cubePrefab.Add<Transform>()
+              .Add<RigidBody>(1.0f, RigidBodyType::Dynamic)
+              .Add<Collider>(Collider::Box(glm::vec3(1.0f)))
+              .Add<Renderable>(MeshType::Cube, glm::vec3(1.0f))
+              .Add<Tag>("Cube");
+    
+    world.Instantiate(cubePrefab, cubeCount, [&](PrefabInstance& cube) {
+        glm::vec3 position(posDistX(gen), posDistY(gen) + 10.0f, posDistZ(gen));
+        glm::vec3 scale(scaleDist(gen));
+        cube.Get<Transform>() = Transform(position, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), scale);
+        
+        // Add physics to cubes
+        auto& rb = cube.Get<RigidBody>();
+        rb.mass = scale.x * 1.0f;
+        rb.linearVelocity = glm::vec3(velDist(gen), 0, velDist(gen));
+        rb.angularVelocity = glm::vec3(angVelDist(gen), angVelDist(gen), angVelDist(gen));
+        rb.friction = 0.5f;
+        rb.restitution = 0.3f;
+        cube.Get<Collider>() = Collider::Box(scale);
+        
+        cube.Get<Renderable>().color = glm::vec3(colorDist(gen), colorDist(gen), colorDist(gen));
+    });
+    
+    // Create static ground plane with physics
+    auto ground = world.CreateEntity();
+    world.AddComponent<Transform>(ground,
+        Transform(glm::vec3(0.0f, -5.0f, 0.0f),
+                  glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                  glm::vec3(100.0f, 0.1f, 100.0f)));
+    world.AddComponent<RigidBody>(ground,
+        RigidBody(0.0f, RigidBodyType::Static));
+    world.AddComponent<Collider>(ground,
+        Collider::Box(glm::vec3(100.0f, 0.1f, 100.0f)));
+    world.AddComponent<Renderable>(ground,
+        Renderable(MeshType::Cube, glm::vec3(0.3f, 0.3f, 0.3f)));
+    world.AddComponent<Tag>(ground, Tag("Ground"));
+    
+    return player;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "ECS/Systems/PhysicsSystem.h"
+
+namespace ECS {
+
+namespace {
+
+const size_t QUERY_GRAIN_SIZE = 64;
+
+// Query shapes live on the worker's stack so batches never touch the heap
+template<typename Func>
+bool WithConvexShape(const Collider& collider, Func&& func) {
+    switch (collider.type) {
+        case ColliderType::Box: {
+            btBoxShape shape(btVector3(collider.size.x, collider.size.y, collider.size.z) * 0.5f);
+            func(static_cast<const btConvexShape&>(shape));
+            return true;
+        }
+        case ColliderType::Sphere: {
+            btSphereShape shape(collider.radius);
+            func(static_cast<const btConvexShape&>(shape));
+            return true;
+        }
+        case ColliderType::Capsule: {
+            btCapsuleShape shape(collider.radius, collider.height);
+            func(static_cast<const btConvexShape&>(shape));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+struct EntityRayCallback : public btCollisionWorld::ClosestRayResultCallback {
+    int ignoreIndex;
+    
+    EntityRayCallback(const btVector3& from, const btVector3& to, uint32_t ignoreEntity)
+        : ClosestRayResultCallback(from, to),
+          ignoreIndex(ignoreEntity ? static_cast<int>(ignoreEntity) : -2) {}
+    
+    btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override {
+        if (rayResult.m_collisionObject->getUserIndex() == ignoreIndex) {
+            return m_closestHitFraction;
+        }
+        return ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+    }
+};
+
+struct EntityConvexCallback : public btCollisionWorld::ClosestConvexResultCallback {
+    int ignoreIndex;
+    
+    EntityConvexCallback(const btVector3& from, const btVector3& to, uint32_t ignoreEntity)
+        : ClosestConvexResultCallback(from, to),
+          ignoreIndex(ignoreEntity ? static_cast<int>(ignoreEntity) : -2) {}
+    
+    btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) override {
+        if (convexResult.m_hitCollisionObject->getUserIndex() == ignoreIndex) {
+            return m_closestHitFraction;
+        }
+        return ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+    }
+};
+
+struct OverlapCallback : public btBroadphaseAabbCallback {
+    uint32_t* hits;
+    uint32_t capacity;
+    uint32_t count = 0;
+    
+    OverlapCallback(uint32_t* out, uint32_t max) : hits(out), capacity(max) {}
+    
+    bool process(const btBroadphaseProxy* proxy) override {
+        auto* object = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+        if (object->getUserIndex() >= 0 && count < capacity) {
+            hits[count++] = static_cast<uint32_t>(object->getUserIndex());
+        }
+        return count < capacity;
+    }
+};
+
+QueryHit NoHit() {
+    QueryHit hit;
+    hit.hit = false;
+    hit.entity = 0;
+    hit.point = glm::vec3(0.0f);
+    hit.normal = glm::vec3(0.0f);
+    hit.fraction = 1.0f;
+    return hit;
+}
+
+}
+
+void PhysicsSystem::RaycastBatch(const RaycastQuery* rays, size_t count, QueryHit* hits) {
+    btDiscreteDynamicsWorld* physicsWorld = dynamicsWorld.get();
+    
+    jobPool->ParallelFor(count, QUERY_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            btVector3 from = GLMToBullet(rays[i].from);
+            btVector3 to = GLMToBullet(rays[i].to);
+            EntityRayCallback callback(from, to, rays[i].ignoreEntity);
+            physicsWorld->rayTest(from, to, callback);
+            
+            QueryHit& hit = hits[i];
+            hit = NoHit();
+            if (callback.hasHit() && callback.m_collisionObject->getUserIndex() >= 0) {
+                hit.hit = true;
+                hit.entity = static_cast<uint32_t>(callback.m_collisionObject->getUserIndex());
+                hit.point = BulletToGLM(callback.m_hitPointWorld);
+                hit.normal = BulletToGLM(callback.m_hitNormalWorld);
+                hit.fraction = callback.m_closestHitFraction;
+            }
+        }
+    });
+}
+
+void PhysicsSystem::SweepBatch(const SweepQuery* sweeps, size_t count, QueryHit* hits) {
+    btDiscreteDynamicsWorld* physicsWorld = dynamicsWorld.get();
+    
+    jobPool->ParallelFor(count, QUERY_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const SweepQuery& sweep = sweeps[i];
+            QueryHit& hit = hits[i];
+            hit = NoHit();
+            
+            btQuaternion rotation = GLMToBullet(sweep.rotation);
+            btTransform from(rotation, GLMToBullet(sweep.from));
+            btTransform to(rotation, GLMToBullet(sweep.to));
+            
+            WithConvexShape(sweep.shape, [&](const btConvexShape& shape) {
+                EntityConvexCallback callback(from.getOrigin(), to.getOrigin(), sweep.ignoreEntity);
+                physicsWorld->convexSweepTest(&shape, from, to, callback);
+                
+                if (callback.hasHit() && callback.m_hitCollisionObject->getUserIndex() >= 0) {
+                    hit.hit = true;
+                    hit.entity = static_cast<uint32_t>(callback.m_hitCollisionObject->getUserIndex());
+                    hit.point = BulletToGLM(callback.m_hitPointWorld);
+                    hit.normal = BulletToGLM(callback.m_hitNormalWorld);
+                    hit.fraction = callback.m_closestHitFraction;
+                }
+            });
+        }
+    });
+}
+
+void PhysicsSystem::OverlapBatch(const OverlapQuery* queries, size_t count, OverlapResults& results) {
+    results.counts.assign(count, 0);
+    results.entities.resize(count * results.maxHitsPerQuery);
+    btDbvtBroadphase* broadphase = overlappingPairCache.get();
+    
+    jobPool->ParallelFor(count, QUERY_GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const OverlapQuery& query = queries[i];
+            btTransform transform(GLMToBullet(query.rotation), GLMToBullet(query.position));
+            
+            WithConvexShape(query.shape, [&](const btConvexShape& shape) {
+                btVector3 aabbMin, aabbMax;
+                shape.getAabb(transform, aabbMin, aabbMax);
+                
+                OverlapCallback callback(
+                    results.entities.data() + i * results.maxHitsPerQuery,
+                    static_cast<uint32_t>(results.maxHitsPerQuery));
+                broadphase->aabbTest(aabbMin, aabbMax, callback);
+                results.counts[i] = callback.count;
+            });
+        }
+    });
+}
+
+}
\ No newline at end of file
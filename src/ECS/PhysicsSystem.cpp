@@ -1,10 +1,21 @@
 #include "ECS/Systems/PhysicsSystem.h"
 #include "ECS/World.h"
-#include <iostream>
+#include "ECS/Log.h"
+#include <algorithm>
 
 namespace ECS {
 
-PhysicsSystem::PhysicsSystem() : gravityEnabled(true), gravity(0.0f, -9.81f, 0.0f) {
+const size_t BULK_OPTIMIZE_THRESHOLD = 256;
+
+// Bullet finds each removed body with a linear search of the non-static
+// bodies, so k removals cost about k times a rebuild's single pass. Past this
+// many, the world is rebuilt around the survivors whatever its size.
+const size_t BULK_REBUILD_THRESHOLD = 512;
+const int RELEASED_BODY = -1;   // User index marking bodies a rebuild leaves out
+
+PhysicsSystem::PhysicsSystem()
+    : gravityEnabled(true), gravity(0.0f, -9.81f, 0.0f),
+      jobPool(&JobPool::Default()), reportAllContacts(false), frameCount(0) {
     RequireComponents<Transform, RigidBody, Collider>();
     SetPriority(50);  // Run AFTER movement and player controller, but before render
     Initialize();
@@ -39,79 +50,242 @@ void PhysicsSystem::Cleanup() {
         delete body;
     }
     rigidBodies.clear();
+    kinematicBodies.clear();
+    dynamicBodies.clear();
     
     for (auto& [id, shape] : collisionShapes) {
         delete shape;
     }
     collisionShapes.clear();
+    retiredShapeLibraries.clear();
 }
 
 void PhysicsSystem::Update(float deltaTime) {
-    std::bitset<MAX_COMPONENTS> mask;
-    mask.set(Component::GetTypeId<Transform>());
-    mask.set(Component::GetTypeId<RigidBody>());
-    mask.set(Component::GetTypeId<Collider>());
-    auto entities = world->GetEntitiesWithComponents(mask);
-    
-    static bool firstRun = true;
-    if (firstRun) {
-        std::cout << "PhysicsSystem: Found " << entities.size() << " entities with physics components" << std::endl;
-        firstRun = false;
-    }
-    
-    static int createdCount = 0;
-    for (auto& entity : entities) {
-        auto* rb = world->GetComponent<RigidBody>(entity);
-        if (!rb->bulletBody) {
-            CreateRigidBody(entity);
-            if (rb->bulletBody) {
-                createdCount++;
-                if (createdCount % 10 == 0) {
-                    std::cout << "Created " << createdCount << " physics bodies" << std::endl;
-                }
-            }
-        }
+    // Later bodies come from the component observers; entities that existed
+    // before this system was added are picked up on the first run
+    if (GetLastRunTick() == 0) {
+        std::bitset<MAX_COMPONENTS> mask;
+        mask.set(Component::GetTypeId<Transform>());
+        mask.set(Component::GetTypeId<RigidBody>());
+        mask.set(Component::GetTypeId<Collider>());
+        auto entities = world->GetEntitiesWithComponents(mask);
+        ECS_LOG_INFO("PhysicsSystem: Found {} entities with physics components", entities.size());
+        CreateRigidBodies(entities);
     }
     
+    StreamKinematicBodies();
     dynamicsWorld->stepSimulation(deltaTime, 10);
+    GatherContactEvents();
     
-    static int frameCount = 0;
     frameCount++;
+    // Sleeping bodies have not moved, so they and their components are left alone
     int syncCount = 0;
-    for (auto& entity : entities) {
-        auto* rb = world->GetComponent<RigidBody>(entity);
-        if (rb && rb->bulletBody && rb->IsDynamic()) {
-            SyncTransformFromBullet(entity);
+    for (auto& dynamic : dynamicBodies) {
+        if (dynamic.body->isActive() && SyncTransformFromBullet(dynamic.entity, dynamic.body)) {
             syncCount++;
         }
     }
     if (frameCount % 60 == 0) {  // Every second at 60fps
-        std::cout << "Syncing " << syncCount << " dynamic bodies from physics" << std::endl;
+        ECS_LOG_DEBUG("Synced {} of {} dynamic bodies from physics", syncCount, dynamicBodies.size());
+    }
+}
+
+void PhysicsSystem::OnAddedToWorld() {
+    auto create = [this](const EntityList& entities) { CreateRigidBodies(entities); };
+    world->OnAdd<Transform>(create);
+    world->OnAdd<RigidBody>(create);
+    world->OnAdd<Collider>(create);
+    
+    // A replaced RigidBody or Collider starts without a body; rebuild it from the new settings
+    auto rebuild = [this](const EntityList& entities) {
+        ReleaseBodies(entities);
+        CreateRigidBodies(entities);
+    };
+    world->OnSet<RigidBody>(rebuild);
+    world->OnSet<Collider>(rebuild);
+    
+    auto release = [this](const EntityList& entities) { ReleaseBodies(entities); };
+    world->OnRemove<Transform>(release);
+    world->OnRemove<RigidBody>(release);
+    world->OnRemove<Collider>(release);
+}
+
+void PhysicsSystem::StreamKinematicBodies() {
+    for (auto& kinematic : kinematicBodies) {
+        const auto* transform = world->ReadComponent<Transform>(kinematic.entity);
+        if (!transform || world->GetComponentTicks<Transform>(kinematic.entity).changed <= GetLastRunTick()) continue;
+        
+        // Bullet reads kinematic poses from the motion state at the start of
+        // the step and derives the body's velocity from the difference, so
+        // dynamic bodies get pushed along instead of tunnelling.
+        btTransform bulletTransform(GLMToBullet(transform->rotation), GLMToBullet(transform->position));
+        kinematic.body->getMotionState()->setWorldTransform(bulletTransform);
     }
 }
 
+void PhysicsSystem::GatherContactEvents() {
+    contactEvents.Clear();
+    currentContacts.clear();
+    
+    int numManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; ++i) {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        int numContacts = manifold->getNumContacts();
+        if (numContacts == 0) continue;
+        
+        const btCollisionObject* objA = manifold->getBody0();
+        const btCollisionObject* objB = manifold->getBody1();
+        if (objA->getUserIndex() < 0 || objB->getUserIndex() < 0) continue;
+        if (!reportAllContacts && objA->getUserIndex2() == 0 && objB->getUserIndex2() == 0) continue;
+        
+        uint32_t idA = static_cast<uint32_t>(objA->getUserIndex());
+        uint32_t idB = static_cast<uint32_t>(objB->getUserIndex());
+        bool swapped = idA > idB;
+        
+        // Report the deepest point and the total impulse of the manifold
+        int deepest = 0;
+        float impulse = 0.0f;
+        for (int p = 0; p < numContacts; ++p) {
+            const btManifoldPoint& pt = manifold->getContactPoint(p);
+            impulse += pt.getAppliedImpulse();
+            if (pt.getDistance() < manifold->getContactPoint(deepest).getDistance()) {
+                deepest = p;
+            }
+        }
+        const btManifoldPoint& pt = manifold->getContactPoint(deepest);
+        
+        ActiveContact contact;
+        contact.key = swapped
+            ? (static_cast<uint64_t>(idB) << 32) | idA
+            : (static_cast<uint64_t>(idA) << 32) | idB;
+        contact.point = BulletToGLM(swapped ? pt.getPositionWorldOnA() : pt.getPositionWorldOnB());
+        contact.normal = BulletToGLM(pt.m_normalWorldOnB) * (swapped ? -1.0f : 1.0f);
+        contact.impulse = impulse;
+        currentContacts.push_back(contact);
+    }
+    
+    // Compound shapes can produce several manifolds per pair; keep the first
+    auto byKey = [](const ActiveContact& a, const ActiveContact& b) { return a.key < b.key; };
+    auto sameKey = [](const ActiveContact& a, const ActiveContact& b) { return a.key == b.key; };
+    std::sort(currentContacts.begin(), currentContacts.end(), byKey);
+    currentContacts.erase(
+        std::unique(currentContacts.begin(), currentContacts.end(), sameKey),
+        currentContacts.end()
+    );
+    
+    // Both lists are sorted, so a single merge pass classifies begin/stay/end
+    auto emit = [this](ContactEventType type, const ActiveContact& c) {
+        ContactEvent event;
+        event.type = type;
+        event.entityA = static_cast<uint32_t>(c.key >> 32);
+        event.entityB = static_cast<uint32_t>(c.key & 0xFFFFFFFFu);
+        event.point = type == ContactEventType::End ? glm::vec3(0.0f) : c.point;
+        event.normal = type == ContactEventType::End ? glm::vec3(0.0f) : c.normal;
+        event.impulse = type == ContactEventType::End ? 0.0f : c.impulse;
+        contactEvents.Push(event);
+    };
+    
+    size_t cur = 0, prev = 0;
+    while (cur < currentContacts.size() || prev < previousContacts.size()) {
+        if (prev == previousContacts.size() ||
+            (cur < currentContacts.size() && currentContacts[cur].key < previousContacts[prev].key)) {
+            emit(ContactEventType::Begin, currentContacts[cur++]);
+        } else if (cur == currentContacts.size() ||
+                   previousContacts[prev].key < currentContacts[cur].key) {
+            emit(ContactEventType::End, previousContacts[prev++]);
+        } else {
+            emit(ContactEventType::Stay, currentContacts[cur++]);
+            prev++;
+        }
+    }
+    
+    std::swap(currentContacts, previousContacts);
+}
+
 void PhysicsSystem::CreateRigidBody(std::shared_ptr<Entity> entity) {
     auto* transform = world->GetComponent<Transform>(entity);
     auto* rb = world->GetComponent<RigidBody>(entity);
     auto* collider = world->GetComponent<Collider>(entity);
     
     if (!transform || !rb || !collider) {
-        std::cout << "ERROR: Missing components for physics body creation!" << std::endl;
+        ECS_LOG_ERROR("Missing components for physics body creation (entity {})", entity->GetId());
         return;
     }
     
-    btCollisionShape* shape = CreateCollisionShape(*collider);
-    if (!shape) return;
+    AddBody(entity, *transform, *rb, *collider);
+}
+
+void PhysicsSystem::CreateRigidBodies(const EntityList& entities) {
+    if (entities.empty()) return;
+    
+    rigidBodies.reserve(rigidBodies.size() + entities.size());
+    collisionShapes.reserve(collisionShapes.size() + entities.size());
+    
+    size_t created = 0;
+    for (auto& entity : entities) {
+        if (!entity->IsActive() ||
+            (entity->GetComponentMask() & requiredComponents) != requiredComponents) {
+            continue;
+        }
+        
+        auto* rb = world->GetComponent<RigidBody>(entity);
+        if (rb->bulletBody) continue;
+        
+        const auto* transform = world->ReadComponent<Transform>(entity);
+        const auto* collider = world->ReadComponent<Collider>(entity);
+        if (AddBody(entity, *transform, *rb, *collider)) {
+            created++;
+        }
+    }
+    
+    // Incremental inserts leave the DBVT unbalanced; rebuild it once for big batches
+    if (created >= BULK_OPTIMIZE_THRESHOLD) {
+        overlappingPairCache->optimize();
+    }
+    
+    if (created > 0) {
+        ECS_LOG_DEBUG("Created {} physics bodies", created);
+    }
+}
+
+bool PhysicsSystem::AddBody(std::shared_ptr<Entity> entity, const Transform& transform, RigidBody& rb, const Collider& collider) {
+    btRigidBody* body = CreateBulletRigidBody(transform, rb, collider);
+    if (!body) return false;
+    
+    uint32_t entityId = entity->GetId();
+    
+    // Entity id travels with the body so contacts map back without lookups
+    body->setUserIndex(static_cast<int>(entityId));
+    body->setUserIndex2(rb.reportContacts ? 1 : 0);
+    
+    dynamicsWorld->addRigidBody(body);
+    
+    rb.bulletBody = body;
+    rb.collisionShape = body->getCollisionShape();
+    rigidBodies[entityId] = body;
+    if (!shapeLibrary) {
+        collisionShapes[entityId] = body->getCollisionShape();
+    }
     
-    collisionShapes[entity->GetId()] = shape;
+    if (rb.IsKinematic()) {
+        kinematicBodies.push_back({entity, body});
+    } else if (rb.IsDynamic()) {
+        dynamicBodies.push_back({entity, body});
+    }
+    return true;
+}
+
+btRigidBody* PhysicsSystem::CreateBulletRigidBody(const Transform& transform, const RigidBody& rb, const Collider& collider) {
+    btCollisionShape* shape = shapeLibrary ? shapeLibrary->Acquire(collider) : CreateCollisionShape(collider);
+    if (!shape) return nullptr;
     
     btTransform startTransform;
     startTransform.setIdentity();
-    startTransform.setOrigin(GLMToBullet(transform->position));
-    startTransform.setRotation(GLMToBullet(transform->rotation));
+    startTransform.setOrigin(GLMToBullet(transform.position));
+    startTransform.setRotation(GLMToBullet(transform.rotation));
     
     btVector3 localInertia(0, 0, 0);
-    float mass = rb->IsStatic() ? 0.0f : rb->mass;
+    float mass = rb.IsStatic() ? 0.0f : rb.mass;
     
     if (mass != 0.0f) {
         shape->calculateLocalInertia(mass, localInertia);
@@ -119,28 +293,22 @@ void PhysicsSystem::CreateRigidBody(std::shared_ptr<Entity> entity) {
     
     btDefaultMotionState* motionState = new btDefaultMotionState(startTransform);
     btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, shape, localInertia);
-    rbInfo.m_friction = rb->friction;
-    rbInfo.m_restitution = rb->restitution;
-    rbInfo.m_linearDamping = rb->linearDamping;
-    rbInfo.m_angularDamping = rb->angularDamping;
+    rbInfo.m_friction = rb.friction;
+    rbInfo.m_restitution = rb.restitution;
+    rbInfo.m_linearDamping = rb.linearDamping;
+    rbInfo.m_angularDamping = rb.angularDamping;
     
     btRigidBody* body = new btRigidBody(rbInfo);
     
-    if (rb->IsKinematic()) {
+    if (rb.IsKinematic()) {
         body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT);
         body->setActivationState(DISABLE_DEACTIVATION);
-    } else if (rb->IsDynamic()) {
-        // Keep dynamic bodies active, especially important for player
-        body->setActivationState(DISABLE_DEACTIVATION);
     }
     
-    body->setLinearVelocity(GLMToBullet(rb->linearVelocity));
-    body->setAngularVelocity(GLMToBullet(rb->angularVelocity));
+    body->setLinearVelocity(GLMToBullet(rb.linearVelocity));
+    body->setAngularVelocity(GLMToBullet(rb.angularVelocity));
     
-    dynamicsWorld->addRigidBody(body);
-    
-    rb->bulletBody = body;
-    rigidBodies[entity->GetId()] = body;
+    return body;
 }
 
 void PhysicsSystem::DestroyRigidBody(std::shared_ptr<Entity> entity) {
@@ -148,6 +316,13 @@ void PhysicsSystem::DestroyRigidBody(std::shared_ptr<Entity> entity) {
     if (it != rigidBodies.end()) {
         btRigidBody* body = it->second;
         
+        auto& tracked = body->isStaticOrKinematicObject() ? kinematicBodies : dynamicBodies;
+        tracked.erase(
+            std::remove_if(tracked.begin(), tracked.end(),
+                [body](const TrackedBody& t) { return t.body == body; }),
+            tracked.end()
+        );
+        
         if (body->getMotionState()) {
             delete body->getMotionState();
         }
@@ -156,6 +331,9 @@ void PhysicsSystem::DestroyRigidBody(std::shared_ptr<Entity> entity) {
         delete body;
         
         rigidBodies.erase(it);
+        if (rigidBodies.empty()) {
+            retiredShapeLibraries.clear();
+        }
     }
     
     auto shapeIt = collisionShapes.find(entity->GetId());
@@ -171,9 +349,150 @@ void PhysicsSystem::DestroyRigidBody(std::shared_ptr<Entity> entity) {
     }
 }
 
+void PhysicsSystem::OnEntitiesDestroyed(const EntityList& entities) {
+    size_t withBodies = 0;
+    for (auto& entity : entities) {
+        withBodies += rigidBodies.count(entity->GetId());
+    }
+    
+    // Level unload: Bullet removes bodies one at a time with a linear search,
+    // so when every body goes it is much cheaper to start a fresh world
+    if (withBodies > 0 && withBodies == rigidBodies.size()) {
+        ResetWorld();
+        return;
+    }
+    ReleaseBodies(entities);
+}
+
+// Frees the bodies by entity id, so it also works once the components are gone
+void PhysicsSystem::ReleaseBodies(const EntityList& entities) {
+    size_t withBodies = 0;
+    for (auto& entity : entities) {
+        withBodies += rigidBodies.count(entity->GetId());
+    }
+    bool rebuild = withBodies >= BULK_REBUILD_THRESHOLD;
+    
+    // Survivors in their current order, so the rebuilt world steps the same way
+    std::vector<btRigidBody*> survivors;
+    std::vector<btRigidBody*> released;
+    if (rebuild) {
+        released.reserve(withBodies);
+        for (auto& entity : entities) {
+            auto it = rigidBodies.find(entity->GetId());
+            if (it == rigidBodies.end()) continue;
+            released.push_back(it->second);
+            it->second->setUserIndex(RELEASED_BODY);   // The body is freed below
+        }
+        
+        const btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+        survivors.reserve(objects.size() - released.size());
+        for (int i = 0; i < objects.size(); ++i) {
+            btRigidBody* body = btRigidBody::upcast(objects[i]);
+            if (body && body->getUserIndex() != RELEASED_BODY) {
+                survivors.push_back(body);
+            }
+        }
+        RecreateDynamicsWorld();
+    }
+    
+    bool removedKinematic = false;
+    bool removedDynamic = false;
+    for (auto& entity : entities) {
+        auto it = rigidBodies.find(entity->GetId());
+        if (it != rigidBodies.end()) {
+            btRigidBody* body = it->second;
+            removedKinematic |= body->isStaticOrKinematicObject();
+            removedDynamic |= !body->isStaticOrKinematicObject();
+            if (body->getMotionState()) {
+                delete body->getMotionState();
+            }
+            if (!rebuild) {
+                dynamicsWorld->removeRigidBody(body);
+            }
+            delete body;
+            rigidBodies.erase(it);
+            
+            if (auto* rb = world->GetComponent<RigidBody>(entity)) {
+                rb->bulletBody = nullptr;
+                rb->collisionShape = nullptr;
+            }
+        }
+        
+        auto shapeIt = collisionShapes.find(entity->GetId());
+        if (shapeIt != collisionShapes.end()) {
+            delete shapeIt->second;
+            collisionShapes.erase(shapeIt);
+        }
+    }
+    
+    if (rebuild) {
+        for (btRigidBody* body : survivors) {
+            dynamicsWorld->addRigidBody(body);
+        }
+        if (survivors.size() >= BULK_OPTIMIZE_THRESHOLD) {
+            overlappingPairCache->optimize();
+        }
+        ECS_LOG_DEBUG("Released {} bodies by rebuilding the world around {}", released.size(), survivors.size());
+    }
+    
+    if (rigidBodies.empty()) {
+        retiredShapeLibraries.clear();
+    }
+    
+    if (removedKinematic) {
+        EraseReleasedBodies(kinematicBodies);
+    }
+    if (removedDynamic) {
+        EraseReleasedBodies(dynamicBodies);
+    }
+}
+
+void PhysicsSystem::EraseReleasedBodies(std::vector<TrackedBody>& bodies) {
+    bodies.erase(
+        std::remove_if(bodies.begin(), bodies.end(),
+            [this](const TrackedBody& t) { return rigidBodies.count(t.entity->GetId()) == 0; }),
+        bodies.end()
+    );
+}
+
+// Drops every body along with the Bullet world, then starts an empty one
+void PhysicsSystem::ResetWorld() {
+    RecreateDynamicsWorld();
+    
+    for (auto& [id, body] : rigidBodies) {
+        delete body->getMotionState();
+        delete body;
+    }
+    rigidBodies.clear();
+    kinematicBodies.clear();
+    dynamicBodies.clear();
+    
+    for (auto& [id, shape] : collisionShapes) {
+        delete shape;
+    }
+    collisionShapes.clear();
+    retiredShapeLibraries.clear();
+}
+
+// Replaces the Bullet world with an empty one. Its bodies are left alive and
+// detached, to be freed or added to the new world.
+void PhysicsSystem::RecreateDynamicsWorld() {
+    // The world's destructor still reads its bodies, so it goes first
+    dynamicsWorld.reset();
+    solver.reset();
+    overlappingPairCache.reset();
+    dispatcher.reset();
+    collisionConfiguration.reset();
+    
+    Initialize();
+    if (!gravityEnabled) {
+        dynamicsWorld->setGravity(btVector3(0, 0, 0));
+    }
+}
+
 void PhysicsSystem::UpdateRigidBody(std::shared_ptr<Entity> entity) {
-    auto* transform = world->GetComponent<Transform>(entity);
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* transform = world->ReadComponent<Transform>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     
     if (!transform || !rb || !rb->bulletBody) return;
     
@@ -194,7 +513,7 @@ void PhysicsSystem::EnableGravity(bool enable) {
     if (dynamicsWorld) {
         btVector3 newGravity = enable ? GLMToBullet(gravity) : btVector3(0, 0, 0);
         dynamicsWorld->setGravity(newGravity);
-        std::cout << "Physics: Gravity set to " << newGravity.getY() << std::endl;
+        ECS_LOG_INFO("Physics: Gravity set to {}", newGravity.getY());
         
         // Wake up all bodies when gravity changes
         for (auto& [id, body] : rigidBodies) {
@@ -206,7 +525,7 @@ void PhysicsSystem::EnableGravity(bool enable) {
 }
 
 void PhysicsSystem::ApplyForce(std::shared_ptr<Entity> entity, const glm::vec3& force, const glm::vec3& relativePos) {
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     if (rb && rb->bulletBody && rb->IsDynamic()) {
         rb->bulletBody->applyForce(GLMToBullet(force), GLMToBullet(relativePos));
         rb->bulletBody->activate();
@@ -214,7 +533,7 @@ void PhysicsSystem::ApplyForce(std::shared_ptr<Entity> entity, const glm::vec3&
 }
 
 void PhysicsSystem::ApplyTorque(std::shared_ptr<Entity> entity, const glm::vec3& torque) {
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     if (rb && rb->bulletBody && rb->IsDynamic()) {
         rb->bulletBody->applyTorque(GLMToBullet(torque));
         rb->bulletBody->activate();
@@ -222,7 +541,7 @@ void PhysicsSystem::ApplyTorque(std::shared_ptr<Entity> entity, const glm::vec3&
 }
 
 void PhysicsSystem::ApplyImpulse(std::shared_ptr<Entity> entity, const glm::vec3& impulse, const glm::vec3& relativePos) {
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     if (rb && rb->bulletBody && rb->IsDynamic()) {
         rb->bulletBody->applyImpulse(GLMToBullet(impulse), GLMToBullet(relativePos));
         rb->bulletBody->activate();
@@ -230,7 +549,7 @@ void PhysicsSystem::ApplyImpulse(std::shared_ptr<Entity> entity, const glm::vec3
 }
 
 void PhysicsSystem::SetLinearVelocity(std::shared_ptr<Entity> entity, const glm::vec3& velocity) {
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     if (rb && rb->bulletBody) {
         rb->bulletBody->setLinearVelocity(GLMToBullet(velocity));
         rb->bulletBody->activate();
@@ -238,7 +557,7 @@ void PhysicsSystem::SetLinearVelocity(std::shared_ptr<Entity> entity, const glm:
 }
 
 void PhysicsSystem::SetAngularVelocity(std::shared_ptr<Entity> entity, const glm::vec3& velocity) {
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     if (rb && rb->bulletBody) {
         rb->bulletBody->setAngularVelocity(GLMToBullet(velocity));
         rb->bulletBody->activate();
@@ -264,25 +583,61 @@ btCollisionShape* PhysicsSystem::CreateCollisionShape(const Collider& collider)
     }
 }
 
-void PhysicsSystem::SyncTransformFromBullet(std::shared_ptr<Entity> entity) {
-    auto* transform = world->GetComponent<Transform>(entity);
-    auto* rb = world->GetComponent<RigidBody>(entity);
-    
-    if (!transform || !rb || !rb->bulletBody) return;
+btCollisionShape* CollisionShapeLibrary::Acquire(const Collider& collider) {
+    ShapeKey key = MakeKey(collider);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& shape = shapes[key];
+    if (!shape) {
+        shape.reset(PhysicsSystem::CreateCollisionShape(collider));
+    }
+    return shape.get();
+}
+
+CollisionShapeLibrary::ShapeKey CollisionShapeLibrary::MakeKey(const Collider& collider) {
+    switch (collider.type) {
+        case ColliderType::Box:
+        case ColliderType::Plane:
+            return {collider.type, {collider.size.x, collider.size.y, collider.size.z}};
+        case ColliderType::Sphere:
+            return {collider.type, {collider.radius, 0.0f, 0.0f}};
+        case ColliderType::Capsule:
+            return {collider.type, {collider.radius, collider.height, 0.0f}};
+        default:
+            return {collider.type, {0.0f, 0.0f, 0.0f}};
+    }
+}
+
+// Writes the body's pose and velocity back, touching each component only if
+// its values differ so change detection sees real motion alone
+bool PhysicsSystem::SyncTransformFromBullet(const std::shared_ptr<Entity>& entity, btRigidBody* body) {
+    const auto* transform = world->ReadComponent<Transform>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
+    if (!transform || !rb) return false;
     
     btTransform bulletTransform;
-    rb->bulletBody->getMotionState()->getWorldTransform(bulletTransform);
-    
-    transform->position = BulletToGLM(bulletTransform.getOrigin());
-    transform->rotation = BulletToGLM(bulletTransform.getRotation());
+    body->getMotionState()->getWorldTransform(bulletTransform);
+    glm::vec3 position = BulletToGLM(bulletTransform.getOrigin());
+    glm::quat rotation = BulletToGLM(bulletTransform.getRotation());
+    glm::vec3 linearVelocity = BulletToGLM(body->getLinearVelocity());
+    glm::vec3 angularVelocity = BulletToGLM(body->getAngularVelocity());
     
-    rb->linearVelocity = BulletToGLM(rb->bulletBody->getLinearVelocity());
-    rb->angularVelocity = BulletToGLM(rb->bulletBody->getAngularVelocity());
+    bool moved = position != transform->position || rotation != transform->rotation;
+    if (moved) {
+        auto* changed = world->GetComponent<Transform>(entity);
+        changed->position = position;
+        changed->rotation = rotation;
+    }
+    if (linearVelocity != rb->linearVelocity || angularVelocity != rb->angularVelocity) {
+        auto* changed = world->GetComponent<RigidBody>(entity);
+        changed->linearVelocity = linearVelocity;
+        changed->angularVelocity = angularVelocity;
+    }
+    return moved;
 }
 
 void PhysicsSystem::SyncTransformToBullet(std::shared_ptr<Entity> entity) {
-    auto* transform = world->GetComponent<Transform>(entity);
-    auto* rb = world->GetComponent<RigidBody>(entity);
+    const auto* transform = world->ReadComponent<Transform>(entity);
+    const auto* rb = world->ReadComponent<RigidBody>(entity);
     
     if (!transform || !rb || !rb->bulletBody) return;
     
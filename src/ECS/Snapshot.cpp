@@ -0,0 +1,471 @@
+#include "ECS/Snapshot.h"
+#include "ECS/Log.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/Velocity.h"
+#include "ECS/Components/RigidBody.h"
+#include "ECS/Components/Collider.h"
+#include "ECS/Components/Renderable.h"
+#include "ECS/Components/Tag.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ECS {
+
+namespace {
+
+const uint64_t SECTION_ALIGNMENT = 16;
+
+uint64_t AlignOffset(uint64_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+// Read-only view of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+        if (fd >= 0) close(fd);
+#endif
+    }
+    
+    bool Open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return false;
+        size = static_cast<size_t>(fileSize.QuadPart);
+        
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        return data != nullptr;
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) return false;
+        size = static_cast<size_t>(info.st_size);
+        
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) return false;
+        data = static_cast<const uint8_t*>(mapped);
+        
+        // Records are consumed front to back exactly once
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        return true;
+#endif
+    }
+    
+    const uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+template<typename Record>
+struct SectionBuilder {
+    std::vector<uint32_t> indices;
+    std::vector<Record> records;
+    
+    void Add(uint32_t index, const Record& record) {
+        indices.push_back(index);
+        records.push_back(record);
+    }
+};
+
+struct PendingSection {
+    SnapshotSection kind;
+    uint32_t recordSize;
+    uint64_t count;
+    const void* indices;
+    const void* data;
+};
+
+template<typename Record>
+void AddPending(std::vector<PendingSection>& sections, SnapshotSection kind, const SectionBuilder<Record>& builder) {
+    if (builder.records.empty()) return;
+    sections.push_back({kind, sizeof(Record), builder.records.size(),
+                        builder.indices.data(), builder.records.data()});
+}
+
+bool WritePadded(FILE* file, uint64_t& position, uint64_t target) {
+    static const char zeros[SECTION_ALIGNMENT] = {};
+    if (target > position && fwrite(zeros, 1, target - position, file) != target - position) {
+        return false;
+    }
+    position = target;
+    return true;
+}
+
+uint32_t ExpectedRecordSize(uint32_t kind) {
+    switch (static_cast<SnapshotSection>(kind)) {
+        case SnapshotSection::Transform: return sizeof(TransformRecord);
+        case SnapshotSection::Velocity: return sizeof(VelocityRecord);
+        case SnapshotSection::RigidBody: return sizeof(RigidBodyRecord);
+        case SnapshotSection::Collider: return sizeof(ColliderRecord);
+        case SnapshotSection::Renderable: return sizeof(RenderableRecord);
+        case SnapshotSection::Tag: return sizeof(TagRecord);
+        case SnapshotSection::Strings: return 1;
+    }
+    return 0;  // Unknown sections from newer writers are skipped
+}
+
+template<typename Record>
+const Record* RecordsOf(const uint8_t* base, const SnapshotSectionHeader& section) {
+    return reinterpret_cast<const Record*>(base + section.dataOffset);
+}
+
+const uint32_t* IndicesOf(const uint8_t* base, const SnapshotSectionHeader& section) {
+    return reinterpret_cast<const uint32_t*>(base + section.indexOffset);
+}
+
+// A section's entities, looked up through its index array without copying
+struct SectionEntities {
+    const EntityList& created;
+    const uint32_t* indices;
+    
+    const std::shared_ptr<Entity>& operator[](size_t i) const { return created[indices[i]]; }
+};
+
+}
+
+bool SaveSnapshot(const World& world, const std::string& path) {
+    SectionBuilder<TransformRecord> transforms;
+    SectionBuilder<VelocityRecord> velocities;
+    SectionBuilder<RigidBodyRecord> rigidBodies;
+    SectionBuilder<ColliderRecord> colliders;
+    SectionBuilder<RenderableRecord> renderables;
+    SectionBuilder<TagRecord> tags;
+    std::vector<char> strings;
+    
+    std::bitset<MAX_COMPONENTS> savedTypes;
+    savedTypes.set(Component::GetTypeId<Transform>());
+    savedTypes.set(Component::GetTypeId<Velocity>());
+    savedTypes.set(Component::GetTypeId<RigidBody>());
+    savedTypes.set(Component::GetTypeId<Collider>());
+    savedTypes.set(Component::GetTypeId<Renderable>());
+    savedTypes.set(Component::GetTypeId<Tag>());
+    
+    // Every saved entity appears in at least one section, which is what lets
+    // the loader bound entityCount by the file's contents
+    uint32_t entityCount = 0;
+    for (auto& entity : world.GetAllEntities()) {
+        if (!entity->IsActive() || (entity->GetComponentMask() & savedTypes).none()) continue;
+        uint32_t index = entityCount++;
+        
+        if (const auto* t = world.ReadComponent<Transform>(entity)) {
+            transforms.Add(index, {t->position, t->rotation, t->scale});
+        }
+        if (const auto* v = world.ReadComponent<Velocity>(entity)) {
+            velocities.Add(index, {v->linear, v->angular});
+        }
+        if (const auto* rb = world.ReadComponent<RigidBody>(entity)) {
+            rigidBodies.Add(index, {rb->mass, static_cast<uint32_t>(rb->type),
+                                    rb->linearVelocity, rb->angularVelocity,
+                                    rb->linearDamping, rb->angularDamping,
+                                    rb->friction, rb->restitution,
+                                    rb->reportContacts ? 1u : 0u});
+        }
+        if (const auto* c = world.ReadComponent<Collider>(entity)) {
+            colliders.Add(index, {static_cast<uint32_t>(c->type), c->size, c->offset, c->radius, c->height});
+        }
+        if (const auto* r = world.ReadComponent<Renderable>(entity)) {
+            renderables.Add(index, {static_cast<uint32_t>(r->meshType), r->color,
+                                    r->visible ? 1u : 0u, r->opacity});
+        }
+        if (const auto* tag = world.ReadComponent<Tag>(entity)) {
+            const std::string& name = tag->GetName();
+            tags.Add(index, {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(name.size())});
+            strings.insert(strings.end(), name.begin(), name.end());
+        }
+    }
+    
+    std::vector<PendingSection> pending;
+    AddPending(pending, SnapshotSection::Transform, transforms);
+    AddPending(pending, SnapshotSection::Velocity, velocities);
+    AddPending(pending, SnapshotSection::RigidBody, rigidBodies);
+    AddPending(pending, SnapshotSection::Collider, colliders);
+    AddPending(pending, SnapshotSection::Renderable, renderables);
+    AddPending(pending, SnapshotSection::Tag, tags);
+    if (!strings.empty()) {
+        pending.push_back({SnapshotSection::Strings, 1, strings.size(), nullptr, strings.data()});
+    }
+    
+    // Lay out the sections first so the table can be written up front
+    std::vector<SnapshotSectionHeader> table;
+    uint64_t offset = sizeof(SnapshotHeader) + pending.size() * sizeof(SnapshotSectionHeader);
+    for (const auto& section : pending) {
+        SnapshotSectionHeader header = {};
+        header.kind = static_cast<uint32_t>(section.kind);
+        header.recordSize = section.recordSize;
+        header.count = section.count;
+        if (section.indices) {
+            header.indexOffset = AlignOffset(offset);
+            offset = header.indexOffset + section.count * sizeof(uint32_t);
+        }
+        header.dataOffset = AlignOffset(offset);
+        offset = header.dataOffset + section.count * section.recordSize;
+        table.push_back(header);
+    }
+    
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.sectionCount = static_cast<uint32_t>(table.size());
+    header.entityCount = entityCount;
+    header.fileSize = offset;
+    
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        ECS_LOG_ERROR("Snapshot: cannot open file for writing");
+        return false;
+    }
+    
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (table.empty() || fwrite(table.data(), sizeof(SnapshotSectionHeader), table.size(), file) == table.size());
+    uint64_t position = sizeof(SnapshotHeader) + table.size() * sizeof(SnapshotSectionHeader);
+    
+    for (size_t i = 0; ok && i < pending.size(); ++i) {
+        const auto& section = pending[i];
+        if (section.indices) {
+            ok = WritePadded(file, position, table[i].indexOffset) &&
+                 fwrite(section.indices, sizeof(uint32_t), section.count, file) == section.count;
+            position += section.count * sizeof(uint32_t);
+        }
+        ok = ok && WritePadded(file, position, table[i].dataOffset) &&
+             fwrite(section.data, section.recordSize, section.count, file) == section.count;
+        position += section.count * section.recordSize;
+    }
+    
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        ECS_LOG_ERROR("Snapshot: write failed");
+        return false;
+    }
+    
+    ECS_LOG_INFO("Snapshot: saved {} entities in {} sections ({} bytes)", entityCount, table.size(), offset);
+    return true;
+}
+
+bool LoadSnapshot(World& world, const std::string& path) {
+    MappedFile file;
+    if (!file.Open(path) || file.GetSize() < sizeof(SnapshotHeader)) {
+        ECS_LOG_ERROR("Snapshot: cannot map file");
+        return false;
+    }
+    
+    const uint8_t* base = file.GetData();
+    const auto* header = reinterpret_cast<const SnapshotHeader*>(base);
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION || header->fileSize != file.GetSize() ||
+        header->entityCount > file.GetSize() / sizeof(uint32_t)) {
+        ECS_LOG_ERROR("Snapshot: not a version {} snapshot or truncated", SNAPSHOT_VERSION);
+        return false;
+    }
+    
+    uint64_t tableEnd = sizeof(SnapshotHeader) + uint64_t(header->sectionCount) * sizeof(SnapshotSectionHeader);
+    if (tableEnd > file.GetSize()) {
+        ECS_LOG_ERROR("Snapshot: section table out of range");
+        return false;
+    }
+    const auto* sections = reinterpret_cast<const SnapshotSectionHeader*>(base + sizeof(SnapshotHeader));
+    
+    // Validate everything before touching the world
+    const SnapshotSectionHeader* stringSection = nullptr;
+    uint64_t indexedRecords = 0;
+    for (uint32_t s = 0; s < header->sectionCount; ++s) {
+        const auto& section = sections[s];
+        uint32_t expected = ExpectedRecordSize(section.kind);
+        if (expected == 0) continue;
+        
+        bool isStrings = section.kind == static_cast<uint32_t>(SnapshotSection::Strings);
+        bool valid = section.recordSize == expected &&
+                     section.count <= file.GetSize() &&
+                     section.dataOffset % SECTION_ALIGNMENT == 0 &&
+                     section.dataOffset <= file.GetSize() &&
+                     section.count * section.recordSize <= file.GetSize() - section.dataOffset;
+        if (valid && !isStrings) {
+            valid = section.indexOffset % SECTION_ALIGNMENT == 0 &&
+                    section.indexOffset <= file.GetSize() &&
+                    section.count * sizeof(uint32_t) <= file.GetSize() - section.indexOffset;
+            const uint32_t* indices = IndicesOf(base, section);
+            for (uint64_t i = 0; valid && i < section.count; ++i) {
+                valid = indices[i] < header->entityCount;
+            }
+        }
+        if (!valid) {
+            ECS_LOG_ERROR("Snapshot: section {} is malformed", section.kind);
+            return false;
+        }
+        if (isStrings) {
+            stringSection = &section;
+        } else {
+            indexedRecords += section.count;
+        }
+    }
+    
+    // Each entity owns at least one record, and no entity gets a component
+    // twice; the bulk adds below rely on both
+    if (header->entityCount > indexedRecords) {
+        ECS_LOG_ERROR("Snapshot: {} entities but only {} records", header->entityCount, indexedRecords);
+        return false;
+    }
+    std::vector<uint8_t> seenKinds(static_cast<size_t>(header->entityCount), 0);
+    for (uint32_t s = 0; s < header->sectionCount; ++s) {
+        const auto& section = sections[s];
+        if (ExpectedRecordSize(section.kind) == 0 ||
+            section.kind == static_cast<uint32_t>(SnapshotSection::Strings)) {
+            continue;
+        }
+        
+        uint8_t bit = static_cast<uint8_t>(1u << section.kind);
+        const uint32_t* indices = IndicesOf(base, section);
+        for (uint64_t i = 0; i < section.count; ++i) {
+            uint8_t& seen = seenKinds[indices[i]];
+            if (seen & bit) {
+                ECS_LOG_ERROR("Snapshot: section {} repeats entity {}", section.kind, indices[i]);
+                return false;
+            }
+            seen |= bit;
+        }
+    }
+    
+    uint64_t stringBytes = stringSection ? stringSection->count : 0;
+    const char* stringData = stringSection ? RecordsOf<char>(base, *stringSection) : nullptr;
+    for (uint32_t s = 0; s < header->sectionCount; ++s) {
+        if (sections[s].kind != static_cast<uint32_t>(SnapshotSection::Tag)) continue;
+        const TagRecord* records = RecordsOf<TagRecord>(base, sections[s]);
+        for (uint64_t i = 0; i < sections[s].count; ++i) {
+            if (uint64_t(records[i].offset) + records[i].length > stringBytes) {
+                ECS_LOG_ERROR("Snapshot: tag string out of range");
+                return false;
+            }
+        }
+    }
+    
+    EntityList created = world.Instantiate(Prefab(), static_cast<size_t>(header->entityCount));
+    
+    for (uint32_t s = 0; s < header->sectionCount; ++s) {
+        const auto& section = sections[s];
+        if (ExpectedRecordSize(section.kind) == 0 ||
+            section.kind == static_cast<uint32_t>(SnapshotSection::Strings)) {
+            continue;
+        }
+        
+        SectionEntities batch = {created, IndicesOf(base, section)};
+        size_t count = static_cast<size_t>(section.count);
+        
+        switch (static_cast<SnapshotSection>(section.kind)) {
+            case SnapshotSection::Transform: {
+                // Same layout as the component, so the records go into storage as is
+                static_assert(sizeof(TransformRecord) == sizeof(Transform) &&
+                              offsetof(TransformRecord, rotation) == offsetof(Transform, rotation) &&
+                              offsetof(TransformRecord, scale) == offsetof(Transform, scale),
+                              "TransformRecord must match Transform");
+                world.CopyComponents<Transform>(batch, count,
+                    reinterpret_cast<const Transform*>(RecordsOf<TransformRecord>(base, section)));
+                break;
+            }
+            case SnapshotSection::Velocity: {
+                static_assert(sizeof(VelocityRecord) == sizeof(Velocity) &&
+                              offsetof(VelocityRecord, angular) == offsetof(Velocity, angular),
+                              "VelocityRecord must match Velocity");
+                world.CopyComponents<Velocity>(batch, count,
+                    reinterpret_cast<const Velocity*>(RecordsOf<VelocityRecord>(base, section)));
+                break;
+            }
+            case SnapshotSection::RigidBody: {
+                const auto* records = RecordsOf<RigidBodyRecord>(base, section);
+                world.AddComponents<RigidBody>(batch, count, [records](size_t i) {
+                    const RigidBodyRecord& r = records[i];
+                    RigidBody rb(r.mass, static_cast<RigidBodyType>(r.type));
+                    rb.linearVelocity = r.linearVelocity;
+                    rb.angularVelocity = r.angularVelocity;
+                    rb.linearDamping = r.linearDamping;
+                    rb.angularDamping = r.angularDamping;
+                    rb.friction = r.friction;
+                    rb.restitution = r.restitution;
+                    rb.reportContacts = r.reportContacts != 0;
+                    return rb;
+                });
+                break;
+            }
+            case SnapshotSection::Collider: {
+                const auto* records = RecordsOf<ColliderRecord>(base, section);
+                world.AddComponents<Collider>(batch, count, [records](size_t i) {
+                    const ColliderRecord& r = records[i];
+                    Collider collider(static_cast<ColliderType>(r.type), r.size);
+                    collider.offset = r.offset;
+                    collider.radius = r.radius;
+                    collider.height = r.height;
+                    return collider;
+                });
+                break;
+            }
+            case SnapshotSection::Renderable: {
+                const auto* records = RecordsOf<RenderableRecord>(base, section);
+                world.AddComponents<Renderable>(batch, count, [records](size_t i) {
+                    const RenderableRecord& r = records[i];
+                    return Renderable(static_cast<MeshType>(r.meshType), r.color, r.visible != 0, r.opacity);
+                });
+                break;
+            }
+            case SnapshotSection::Tag: {
+                const auto* records = RecordsOf<TagRecord>(base, section);
+                world.AddComponents<Tag>(batch, count, [records, stringData](size_t i) {
+                    const TagRecord& r = records[i];
+                    return Tag(r.length ? std::string_view(stringData + r.offset, r.length) : std::string_view());
+                });
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    
+    ECS_LOG_INFO("Snapshot: loaded {} entities", header->entityCount);
+    return true;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+// Headless simulation server: runs the demo world (physics, player control,
+// movement, bounds) at a fixed tick rate with scripted or recorded input and
+// no GL context, then reports tick time percentiles.
+
+#include "ECS/World.h"
+#include "ECS/AllocationCounter.h"
+#include "ECS/DemoScene.h"
+#include "ECS/Log.h"
+#include "ECS/InputRecording.h"
+#include "ECS/Systems/ScriptedInputSystem.h"
+#include "ECS/Systems/InputReplaySystem.h"
+#include "ECS/Systems/DemoControlSystem.h"
+#include "ECS/Systems/PlayerControllerSystem.h"
+#include "ECS/Systems/MovementSystem.h"
+#include "ECS/Systems/BoundsSystem.h"
+#include "ECS/Systems/TransformHierarchySystem.h"
+#include "ECS/Systems/SpatialIndexSystem.h"
+#include "ECS/Systems/PhysicsSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ServerOptions {
+    uint64_t ticks = 600;
+    double tickRate = 60.0;
+    int cubeCount = 100;
+    uint32_t seed = 1;
+    std::string scriptPath;
+    std::string replayPath;
+    bool fast = false;  // Run ticks back to back instead of pacing to wall time
+};
+
+void PrintUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --ticks N      Number of ticks to simulate (default 600)\n"
+           "  --rate HZ      Fixed tick rate (default 60)\n"
+           "  --cubes N      Number of cubes in the demo scene (default 100)\n"
+           "  --seed N       Seed for scene generation (default 1)\n"
+           "  --script FILE  Scripted input, lines of \"<tick> <key> <down|up>\"\n"
+           "  --replay FILE  Replay a CubeRendererECS --record file at full speed\n"
+           "  --fast         Do not sleep between ticks\n", program);
+}
+
+bool ParseOptions(int argc, char** argv, ServerOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--ticks") == 0 && hasValue) {
+            options.ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(arg, "--rate") == 0 && hasValue) {
+            options.tickRate = std::atof(argv[++i]);
+        } else if (strcmp(arg, "--cubes") == 0 && hasValue) {
+            options.cubeCount = std::atoi(argv[++i]);
+        } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(arg, "--script") == 0 && hasValue) {
+            options.scriptPath = argv[++i];
+        } else if (strcmp(arg, "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (strcmp(arg, "--fast") == 0) {
+            options.fast = true;
+        } else {
+            return false;
+        }
+    }
+    return options.tickRate > 0.0 && options.cubeCount >= 0;
+}
+
+// FNV-1a over every Transform, to confirm two runs ended in the same state
+uint64_t StateChecksum(const ECS::World& world) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    for (auto& entity : world.GetAllEntities()) {
+        if (const auto* transform = world.ReadComponent<ECS::Transform>(entity)) {
+            mix(&transform->position, sizeof(transform->position));
+            mix(&transform->rotation, sizeof(transform->rotation));
+        }
+    }
+    return hash;
+}
+
+double Percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+}
+
+int main(int argc, char** argv) {
+    ServerOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    
+    ECS::World world;
+    
+    // A replay brings its own seed, scene size and frame timing
+    ECS::InputRecording recording;
+    ECS::InputReplaySystem* replay = nullptr;
+    if (!options.replayPath.empty()) {
+        if (!recording.Load(options.replayPath)) {
+            fprintf(stderr, "Failed to load input recording %s\n", options.replayPath.c_str());
+            return 1;
+        }
+        options.seed = static_cast<uint32_t>(recording.seed);
+        options.cubeCount = static_cast<int>(recording.cubeCount);
+        options.ticks = recording.frames.size();
+        options.fast = true;
+        
+        auto replaySystem = std::make_unique<ECS::InputReplaySystem>(&recording);
+        replay = replaySystem.get();
+        world.AddSystem(std::move(replaySystem));
+    } else {
+        auto inputSystem = std::make_unique<ECS::ScriptedInputSystem>();
+        if (!options.scriptPath.empty() && !inputSystem->LoadScript(options.scriptPath)) {
+            fprintf(stderr, "Failed to load input script %s\n", options.scriptPath.c_str());
+            return 1;
+        }
+        world.AddSystem(std::move(inputSystem));
+    }
+    world.AddSystem(std::make_unique<ECS::PhysicsSystem>());
+    world.AddSystem(std::make_unique<ECS::PlayerControllerSystem>());
+    world.AddSystem(std::make_unique<ECS::DemoControlSystem>(options.seed + 1));
+    world.AddSystem(std::make_unique<ECS::MovementSystem>());
+    world.AddSystem(std::make_unique<ECS::BoundsSystem>());
+    world.AddSystem(std::make_unique<ECS::TransformHierarchySystem>());
+    world.AddSystem(std::make_unique<ECS::SpatialIndexSystem>());
+    
+    std::mt19937 gen(options.seed);
+    ECS::CreateDemoScene(world, gen, options.cubeCount);
+    
+    using Clock = std::chrono::steady_clock;
+    const float tickDelta = static_cast<float>(1.0 / options.tickRate);
+    const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / options.tickRate));
+    
+    std::vector<double> tickTimesMs;
+    tickTimesMs.reserve(options.ticks);
+    std::vector<uint32_t> tickAllocations;
+    tickAllocations.reserve(options.ticks);
+    uint64_t overruns = 0;
+    
+    auto nextTick = Clock::now();
+    auto runStart = nextTick;
+    for (uint64_t tick = 0; tick < options.ticks; ++tick) {
+        float delta = replay ? replay->GetNextDeltaTime() : tickDelta;
+        auto start = Clock::now();
+        world.Update(delta);
+        auto end = Clock::now();
+        tickTimesMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        tickAllocations.push_back(world.GetProfiler().GetFrame(0).allocations);
+        
+        if (!options.fast) {
+            nextTick += tickPeriod;
+            if (end > nextTick) {
+                // Fell behind; resynchronise rather than bursting to catch up
+                overruns++;
+                nextTick = end;
+            } else {
+                std::this_thread::sleep_until(nextTick);
+            }
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    
+    ECS::Logger::Get().Flush();
+    
+    std::vector<double> sorted = tickTimesMs;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double t : sorted) total += t;
+    
+    printf("Simulated %llu ticks at %.1f Hz with %zu entities in %.2f s\n",
+           static_cast<unsigned long long>(options.ticks), options.tickRate,
+           world.GetAllEntities().size(), wallSeconds);
+    printf("Tick time (ms): mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+           sorted.empty() ? 0.0 : total / sorted.size(),
+           Percentile(sorted, 0.50), Percentile(sorted, 0.90),
+           Percentile(sorted, 0.99), sorted.empty() ? 0.0 : sorted.back());
+    if (ECS::AllocationCounter::IsTracking() && !tickAllocations.empty()) {
+        // The second half of the run stands in for steady state, past scene warm-up
+        uint32_t steadyMax = 0;
+        uint64_t allocatingTicks = 0;
+        for (size_t i = tickAllocations.size() / 2; i < tickAllocations.size(); ++i) {
+            steadyMax = std::max(steadyMax, tickAllocations[i]);
+            if (tickAllocations[i] > 0) allocatingTicks++;
+        }
+        printf("Heap allocations per tick: first %u, steady state max %u (%llu of %zu ticks allocated)\n",
+               tickAllocations.front(), steadyMax, static_cast<unsigned long long>(allocatingTicks),
+               tickAllocations.size() - tickAllocations.size() / 2);
+    }
+    printf("State checksum: %016llx\n", static_cast<unsigned long long>(StateChecksum(world)));
+    if (!options.fast) {
+        printf("Ticks over budget (%.3f ms): %llu\n", 1000.0 / options.tickRate,
+               static_cast<unsigned long long>(overruns));
+    }
+    
+    return 0;
+}
\ No newline at end of file